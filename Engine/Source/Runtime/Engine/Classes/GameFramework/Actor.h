@@ -2763,6 +2763,16 @@ public:
 	 */
 	virtual float TakeDamage(float DamageAmount, struct FDamageEvent const& DamageEvent, class AController* EventInstigator, AActor* DamageCauser);
 
+//#NAUSEA_BEGIN_RADIAL_DAMAGE_BATCH UGameplayStatics::ApplyRadialDamageWithFalloff goes through an intermediate TMap of hit lists per actor.
+	/**
+	 * Applies radial damage with falloff to every damageable actor within DamageOuterRadius of Origin.
+	 * Overlaps are gathered once and grouped per actor. Like UGameplayStatics::ApplyRadialDamage, every visible component hit is kept in the FRadialDamageEvent and only the closest one drives falloff.
+	 * Each victim still goes through its own TakeDamage. Engine code cannot reach game side damage queues, so batching the application itself is left to the victims.
+	 * @return true if damage was applied to at least one actor.
+	 */
+	static bool ApplyRadialDamageBatch(const UObject* WorldContextObject, float BaseDamage, float MinimumDamage, const FVector& Origin, float DamageInnerRadius, float DamageOuterRadius, float DamageFalloff, TSubclassOf<class UDamageType> DamageTypeClass, const TArray<AActor*>& IgnoreActors, AActor* DamageCauser = nullptr, class AController* InstigatedByController = nullptr, ECollisionChannel DamagePreventionChannel = ECC_Visibility);
+//#NAUSEA_END_RADIAL_DAMAGE_BATCH
+
 protected:
 	virtual float InternalTakeRadialDamage(float Damage, struct FRadialDamageEvent const& RadialDamageEvent, class AController* EventInstigator, AActor* DamageCauser);
 	virtual float InternalTakePointDamage(float Damage, struct FPointDamageEvent const& PointDamageEvent, class AController* EventInstigator, AActor* DamageCauser);
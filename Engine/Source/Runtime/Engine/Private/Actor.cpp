@@ -2507,6 +2507,122 @@ float AActor::InternalTakeRadialDamage(float Damage, FRadialDamageEvent const& R
 	return ActualDamage;
 }
 
+//#NAUSEA_BEGIN_RADIAL_DAMAGE_BATCH
+/** Same visibility test as UGameplayStatics' (non exported) ComponentIsDamageableFrom. */
+static bool IsComponentDamageableFrom(UPrimitiveComponent* VictimComp, FVector const& Origin, const TArray<AActor*>& IgnoreActors, ECollisionChannel TraceChannel, FHitResult& OutHitResult)
+{
+	FCollisionQueryParams LineParams(SCENE_QUERY_STAT(ComponentIsVisibleFrom), true);
+	LineParams.AddIgnoredActors(IgnoreActors);
+
+	UWorld* const World = VictimComp->GetWorld();
+	check(World);
+
+	FVector const TraceEnd = VictimComp->Bounds.Origin;
+	FVector TraceStart = Origin;
+	if (Origin == TraceEnd)
+	{
+		// tiny nudge so LineTraceSingle doesn't early out with no hits
+		TraceStart.Z += 0.01f;
+	}
+
+	// Only do a line trace if there is a valid channel, if it is invalid then result will have no fall off
+	if (TraceChannel != ECollisionChannel::ECC_MAX)
+	{
+		if (World->LineTraceSingleByChannel(OutHitResult, TraceStart, TraceEnd, TraceChannel, LineParams))
+		{
+			// if the blocking hit was the victim component it is visible, otherwise something else is blocking the damage
+			return OutHitResult.Component == VictimComp;
+		}
+	}
+
+	// didn't hit anything, model the damage as having hit a point at the component's center
+	FVector const FakeHitLoc = VictimComp->GetComponentLocation();
+	FVector const FakeHitNorm = (Origin - FakeHitLoc).GetSafeNormal();
+	OutHitResult = FHitResult(VictimComp->GetOwner(), VictimComp, FakeHitLoc, FakeHitNorm);
+	return true;
+}
+
+bool AActor::ApplyRadialDamageBatch(const UObject* WorldContextObject, float BaseDamage, float MinimumDamage, const FVector& Origin, float DamageInnerRadius, float DamageOuterRadius, float DamageFalloff, TSubclassOf<UDamageType> DamageTypeClass, const TArray<AActor*>& IgnoreActors, AActor* DamageCauser, AController* InstigatedByController, ECollisionChannel DamagePreventionChannel)
+{
+	UWorld* const World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	if (!World)
+	{
+		return false;
+	}
+
+	FCollisionQueryParams SphereParams(SCENE_QUERY_STAT(ApplyRadialDamageBatch), false, DamageCauser);
+	SphereParams.AddIgnoredActors(IgnoreActors);
+
+	TArray<FOverlapResult> Overlaps;
+	World->OverlapMultiByObjectType(Overlaps, Origin, FQuat::Identity, FCollisionObjectQueryParams(FCollisionObjectQueryParams::InitType::AllDynamicObjects), FCollisionShape::MakeSphere(DamageOuterRadius), SphereParams);
+
+	struct FRadialDamageVictim
+	{
+		AActor* Actor;
+		TArray<FHitResult> ComponentHits;
+	};
+
+	TArray<FRadialDamageVictim> VictimList;
+	VictimList.Reserve(Overlaps.Num());
+	TMap<AActor*, int32> VictimIndexMap;
+	VictimIndexMap.Reserve(Overlaps.Num());
+
+	// single pass over the overlaps, grouping the visible component hits of each actor
+	FHitResult Hit;
+	for (const FOverlapResult& Overlap : Overlaps)
+	{
+		AActor* const OverlapActor = Overlap.GetActor();
+		UPrimitiveComponent* const OverlapComponent = Overlap.Component.Get();
+
+		if (!OverlapActor || !OverlapComponent || !OverlapActor->CanBeDamaged() || OverlapActor == DamageCauser)
+		{
+			continue;
+		}
+
+		if (!IsComponentDamageableFrom(OverlapComponent, Origin, IgnoreActors, DamagePreventionChannel, Hit))
+		{
+			continue;
+		}
+
+		if (const int32* const VictimIndex = VictimIndexMap.Find(OverlapActor))
+		{
+			VictimList[*VictimIndex].ComponentHits.Add(Hit);
+		}
+		else
+		{
+			VictimIndexMap.Add(OverlapActor, VictimList.Add({ OverlapActor, { Hit } }));
+		}
+	}
+
+	if (VictimList.Num() == 0)
+	{
+		return false;
+	}
+
+	FRadialDamageEvent DmgEvent;
+	DmgEvent.DamageTypeClass = DamageTypeClass ? DamageTypeClass : UDamageType::StaticClass();
+	DmgEvent.Origin = Origin;
+	DmgEvent.Params = FRadialDamageParams(BaseDamage, MinimumDamage, DamageInnerRadius, DamageOuterRadius, DamageFalloff);
+
+	bool bAppliedDamage = false;
+	for (FRadialDamageVictim& Victim : VictimList)
+	{
+		// an earlier victim's damage may have destroyed this one
+		if (Victim.Actor->IsPendingKillPending())
+		{
+			continue;
+		}
+
+		// every hit component is kept so that ReceiveComponentDamage reaches each of them, InternalTakeRadialDamage only uses the closest one for falloff
+		DmgEvent.ComponentHits = MoveTemp(Victim.ComponentHits);
+		Victim.Actor->TakeDamage(BaseDamage, DmgEvent, InstigatedByController, DamageCauser);
+		bAppliedDamage = true;
+	}
+
+	return bAppliedDamage;
+}
+//#NAUSEA_END_RADIAL_DAMAGE_BATCH
+
 float AActor::InternalTakePointDamage(float Damage, FPointDamageEvent const& PointDamageEvent, AController* EventInstigator, AActor* DamageCauser)
 {
 	return Damage;
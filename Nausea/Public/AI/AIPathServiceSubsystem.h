@@ -0,0 +1,128 @@
+// Copyright 2020-2021 Jean-David Veilleux-Foppiano. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "NavigationSystemTypes.h"
+#include "NavFilters/NavigationQueryFilter.h"
+#include "AIPathServiceSubsystem.generated.h"
+
+class UActionMoveTo;
+
+//A path query shared by every request made with a nearby start location toward the same goal.
+USTRUCT()
+struct FPathServiceQuery
+{
+	GENERATED_USTRUCT_BODY()
+
+	FPathServiceQuery() {}
+
+public:
+	UPROPERTY()
+	FVector StartLocation = FVector::ZeroVector;
+	UPROPERTY()
+	FVector GoalLocation = FVector::ZeroVector;
+	UPROPERTY()
+	TSubclassOf<UNavigationQueryFilter> FilterClass = nullptr;
+	UPROPERTY()
+	bool bAllowPartialPath = false;
+
+	UPROPERTY()
+	TArray<TWeakObjectPtr<UActionMoveTo>> RequesterList;
+
+	//ID of the async query once dispatched. INDEX_NONE while waiting for budget.
+	UPROPERTY()
+	int32 AsyncQueryID = INDEX_NONE;
+};
+
+//Recently computed path kept so that requests made shortly after can reuse it without a new query.
+USTRUCT()
+struct FPathServiceCacheEntry
+{
+	GENERATED_USTRUCT_BODY()
+
+	FPathServiceCacheEntry() {}
+
+public:
+	UPROPERTY()
+	FVector StartLocation = FVector::ZeroVector;
+	UPROPERTY()
+	FVector GoalLocation = FVector::ZeroVector;
+	UPROPERTY()
+	TSubclassOf<UNavigationQueryFilter> FilterClass = nullptr;
+	UPROPERTY()
+	float CreationTime = -1.f;
+
+	FNavPathSharedPtr Path;
+};
+
+/**
+ * Path finding service used by UActionMoveTo. Requests with start locations within StartMergeRadius of each other toward goals within GoalMergeRadius of each other are merged into a single query,
+ * as long as the starts can share a corridor (see CanShareCorridor). Queries are run asynchronously on the navigation system, at most MaxQueriesPerFrame dispatched per frame.
+ * Results are cached briefly and handed to every requester, each receiving its own copy of the path starting at its own location.
+ */
+UCLASS(Config = Game)
+class NAUSEA_API UAIPathServiceSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+//~ Begin USubsystem Interface
+public:
+	virtual void Deinitialize() override;
+//~ End USubsystem Interface
+
+//~ Begin FTickableGameObject Interface
+protected:
+	virtual void Tick(float DeltaTime) override;
+public:
+	virtual ETickableTickType GetTickableTickType() const { return ETickableTickType::Conditional; }
+	virtual bool IsTickable() const { return QueryList.Num() > 0 || PathCacheList.Num() > 0; }
+	virtual TStatId GetStatId() const { return TStatId(); }
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+//~ End FTickableGameObject Interface
+
+public:
+	static UAIPathServiceSubsystem* Get(const UObject* WorldContextObject);
+
+	//Requester receives UActionMoveTo::OnPathServiceResult, possibly during this call if a cached path can be reused. Replaces any request the requester already had in flight.
+	void RequestPath(UActionMoveTo* Requester, const FVector& StartLocation, const FVector& GoalLocation, TSubclassOf<UNavigationQueryFilter> FilterClass, bool bAllowPartialPath);
+	void CancelRequest(UActionMoveTo* Requester);
+
+protected:
+	const FPathServiceCacheEntry* FindCachedPath(const FVector& StartLocation, const FVector& GoalLocation, TSubclassOf<UNavigationQueryFilter> FilterClass) const;
+	FPathServiceQuery* FindMergeableQuery(const FVector& StartLocation, const FVector& GoalLocation, TSubclassOf<UNavigationQueryFilter> FilterClass, bool bAllowPartialPath);
+
+	//Returns true if a path computed from StartLocation can be spliced onto RequesterLocation. Both must project onto the same navmesh poly or have an unobstructed navmesh raycast between them,
+	//so that a shared path never leads a requester through a wall or onto another floor.
+	bool CanShareCorridor(const FVector& StartLocation, const FVector& RequesterLocation, TSubclassOf<UNavigationQueryFilter> FilterClass) const;
+
+	void DispatchQueries();
+	void OnAsyncPathQueryFinished(uint32 AsyncQueryID, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path);
+
+	//Sends Path (or failure if it is invalid) to every requester of the query.
+	void DeliverPath(const FPathServiceQuery& Query, FNavPathSharedPtr Path);
+
+	void ExpirePathCache();
+
+protected:
+	UPROPERTY(Config)
+	int32 MaxQueriesPerFrame = 4;
+
+	//Kept small since merged requesters skip their own path start. Merges are also subject to CanShareCorridor.
+	UPROPERTY(Config)
+	float StartMergeRadius = 50.f;
+	UPROPERTY(Config)
+	float GoalMergeRadius = 100.f;
+
+	UPROPERTY(Config)
+	float PathCacheLifetime = 0.5f;
+
+	//Pending (not yet dispatched) queries first, in request order, followed by in flight ones.
+	UPROPERTY(Transient)
+	TArray<FPathServiceQuery> QueryList;
+
+	UPROPERTY(Transient)
+	TArray<FPathServiceCacheEntry> PathCacheList;
+};
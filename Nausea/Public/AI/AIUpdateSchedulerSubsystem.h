@@ -0,0 +1,125 @@
+// Copyright 2020-2021 Jean-David Veilleux-Foppiano. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "AIUpdateSchedulerSubsystem.generated.h"
+
+class UActionBrainComponent;
+
+UENUM(BlueprintType)
+enum class EAIUpdateLOD : uint8
+{
+	High, //In combat, close to or in view of a player.
+	Medium,
+	Low, //Far from and out of view of every player.
+	MAX UMETA(Hidden)
+};
+
+USTRUCT()
+struct FScheduledBrainEntry
+{
+	GENERATED_USTRUCT_BODY()
+
+	FScheduledBrainEntry() {}
+
+	FScheduledBrainEntry(UActionBrainComponent* InBrain, float InWorldTime)
+		: Brain(InBrain), LastUpdateTime(InWorldTime) {}
+
+public:
+	UPROPERTY()
+	TWeakObjectPtr<UActionBrainComponent> Brain = nullptr;
+	//World time of this brain's last update. The brain receives the time elapsed since then as its delta time.
+	UPROPERTY()
+	float LastUpdateTime = 0.f;
+	UPROPERTY()
+	EAIUpdateLOD UpdateLOD = EAIUpdateLOD::High;
+};
+
+/**
+ * Updates every registered UActionBrainComponent (and the enemy selection and routine manager components of its controller) within a fixed per-frame time budget.
+ * Brains are visited round robin. Each brain's LOD, derived from its distance to players, whether it is in combat and whether it is in any player's view, sets the minimum interval between its updates.
+ * Brains that are due but do not fit in a frame's budget are the first visited on the next frame.
+ */
+UCLASS(Config = Game)
+class NAUSEA_API UAIUpdateSchedulerSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+//~ Begin USubsystem Interface
+public:
+	virtual void Deinitialize() override;
+//~ End USubsystem Interface
+
+//~ Begin FTickableGameObject Interface
+protected:
+	virtual void Tick(float DeltaTime) override;
+public:
+	virtual ETickableTickType GetTickableTickType() const { return ETickableTickType::Conditional; }
+	virtual bool IsTickable() const { return ScheduledBrainList.Num() > 0; }
+	virtual TStatId GetStatId() const { return TStatId(); }
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+//~ End FTickableGameObject Interface
+
+public:
+	static UAIUpdateSchedulerSubsystem* Get(const UObject* WorldContextObject);
+
+	//Takes over updating the brain. Its component tick is disabled until it is unregistered.
+	void RegisterBrain(UActionBrainComponent* Brain);
+	void UnregisterBrain(UActionBrainComponent* Brain);
+
+	float GetUpdateInterval(EAIUpdateLOD UpdateLOD) const
+	{
+		switch (UpdateLOD)
+		{
+		case EAIUpdateLOD::Medium:
+			return MediumLODUpdateInterval;
+		case EAIUpdateLOD::Low:
+			return LowLODUpdateInterval;
+		default:
+			break;
+		}
+
+		return HighLODUpdateInterval;
+	}
+
+protected:
+	//Recomputes the LOD of every brain. Run every RelevanceUpdateInterval rather than every frame.
+	void UpdateRelevance();
+	EAIUpdateLOD CalculateUpdateLOD(const UActionBrainComponent* Brain) const;
+
+protected:
+	//Time, in milliseconds, brains are allowed to take per frame. At least one brain is updated every frame regardless.
+	UPROPERTY(Config)
+	float FrameBudgetMs = 2.f;
+
+	//Minimum time between updates of a brain at each EAIUpdateLOD.
+	UPROPERTY(Config)
+	float HighLODUpdateInterval = 0.f;
+	UPROPERTY(Config)
+	float MediumLODUpdateInterval = 0.1f;
+	UPROPERTY(Config)
+	float LowLODUpdateInterval = 0.4f;
+
+	UPROPERTY(Config)
+	float HighLODDistance = 1500.f;
+	UPROPERTY(Config)
+	float MediumLODDistance = 4000.f;
+	//Cosine of the half angle of a player's view cone used to decide if a brain's pawn is in view.
+	UPROPERTY(Config)
+	float InViewConeCosine = 0.5f;
+
+	UPROPERTY(Config)
+	float RelevanceUpdateInterval = 0.5f;
+	UPROPERTY(Transient)
+	float LastRelevanceUpdateTime = -1.f;
+
+	UPROPERTY(Transient)
+	TArray<FScheduledBrainEntry> ScheduledBrainList;
+
+	//Index of the next brain to visit.
+	UPROPERTY(Transient)
+	int32 RoundRobinIndex = 0;
+};
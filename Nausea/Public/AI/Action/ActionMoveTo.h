@@ -62,6 +62,14 @@ protected:
 	UPROPERTY()
 	uint32 bAbortChildActionOnPathChange : 1;
 
+	/** if set, paths are requested through the UAIPathServiceSubsystem instead of being found synchronously */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Action)
+	uint32 bUsePathService : 1;
+
+	/** goal actor must move this far from the location the current path was built toward before a repath is requested */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Action)
+	float RepathDistanceThreshold = 200.f;
+
 public:
 	virtual void BeginDestroy() override;
 
@@ -73,6 +81,9 @@ public:
 	void SetPath(FNavPathSharedRef InPath);
 	virtual void OnPathUpdated(FNavigationPath* UpdatedPath, ENavPathEvent::Type Event);
 
+	/** called by the UAIPathServiceSubsystem when a requested path is ready. InPath is invalid if no path was found */
+	virtual void OnPathServiceResult(FNavPathSharedPtr InPath);
+
 	void SetAcceptableRadius(float NewAcceptableRadius) { AcceptableRadius = NewAcceptableRadius; }
 	void SetFinishOnOverlap(bool bNewFinishOnOverlap) { bFinishOnOverlap = bNewFinishOnOverlap; }
 	void EnableStrafing(bool bNewStrafing) { bAllowStrafe = bNewStrafing; }
@@ -97,6 +108,12 @@ protected:
 	/** Handle for efficient management of TryToRepath timer */
 	FTimerHandle TimerHandle_TryToRepath;
 
+	/** goal location the current path (or pending path service request) was built toward */
+	FVector PathGoalLocation = FAISystem::InvalidLocation;
+
+	/** true while waiting on a UAIPathServiceSubsystem result */
+	bool bWaitingForPathService = false;
+
 	void ClearPath();
 	virtual bool Start() override;
 	virtual bool Pause(const UActionBrainComponentAction* PausedBy) override;
@@ -115,6 +132,9 @@ protected:
 	UFUNCTION()
 	void OnActionDataObjectReady(UActionBrainDataObject* DataObject);
 
+	/** returns true if the goal has moved far enough from PathGoalLocation to justify a new path */
+	bool ShouldRepath() const;
+
 	void TryToRepath();
 	void ClearPendingRepath();
 	void ClearTimers();
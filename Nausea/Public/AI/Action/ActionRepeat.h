@@ -23,6 +23,7 @@ class NAUSEA_API UActionRepeat : public UActionBrainComponentAction
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Instanced, Category = Action)
 	UActionBrainComponentAction* ActionToRepeat;
 
+	/** copy of ActionToRepeat being run. Once finished it is reset and pushed again on the next tick for the next iteration instead of making a new copy */
 	UPROPERTY(Transient)
 	UActionBrainComponentAction* RecentActionCopy;
 
@@ -34,6 +35,9 @@ class NAUSEA_API UActionRepeat : public UActionBrainComponentAction
 
 	EPawnSubActionTriggeringPolicy::Type SubActionTriggeringPolicy;
 
+	/** set by OnChildFinished. The copy is still finishing (and broadcasting) at that point, so it is reset and pushed again from Tick */
+	uint32 bPendingSubActionPush : 1;
+
 public:
 	UFUNCTION(BlueprintCallable, Category = Action, meta = (WorldContext = "WorldContextObject", CallableWithoutWorldContext))
 	static UActionRepeat* CreateRepeatAction(const UObject* WorldContextObject, UActionBrainComponentAction* Action, int32 NumberOfRepeats = -1,
@@ -45,8 +49,15 @@ protected:
 	virtual bool Resume() override;
 	virtual void OnChildFinished(UActionBrainComponentAction* Action, EPawnActionResult::Type WithResult) override;
 	virtual void Finish(TEnumAsByte<EPawnActionResult::Type> WithResult) override;
+	virtual void Tick(float DeltaTime) override;
 	virtual FString GetDebugInfoString(int32 Depth) const;
+public:
+	virtual void ResetAction() override;
 //~ End UActionBrainComponentAction Interface
 
+protected:
 	bool PushSubAction();
+
+	/** returns RecentActionCopy reset for another run, or a new copy of ActionToRepeat if there is none yet */
+	UActionBrainComponentAction* GetActionCopy();
 };
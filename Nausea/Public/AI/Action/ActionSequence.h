@@ -23,10 +23,17 @@ class NAUSEA_API UActionSequence : public UActionBrainComponentAction
 	UPROPERTY(Transient)
 	UActionBrainComponentAction* RecentActionCopy;
 
+	/** copies of ActionSequence entries, indexed like ActionSequence. Reset and reused whenever the sequence runs again, never while they are still finishing */
+	UPROPERTY(Transient)
+	TArray<UActionBrainComponentAction*> ActionCopyList;
+
 	uint32 CurrentActionIndex;
 
 	EPawnSubActionTriggeringPolicy::Type SubActionTriggeringPolicy;
 
+	/** set by OnChildFinished. The finished copy is still on the stack at that point, so the next copy is pushed from Tick */
+	uint32 bPendingNextActionPush : 1;
+
 	UFUNCTION(BlueprintCallable, Category = Action, meta = (WorldContext = "WorldContextObject", CallableWithoutWorldContext))
 	static UActionSequence* CreateSequenceAction(const UObject* WorldContextObject, TArray<UActionBrainComponentAction*> Actions,
 		TEnumAsByte<EPawnActionFailHandling::Type> FailureHandlingMode = EPawnActionFailHandling::RequireSuccess);
@@ -37,8 +44,15 @@ protected:
 	virtual bool Resume() override;
 	virtual void OnChildFinished(UActionBrainComponentAction* Action, EPawnActionResult::Type WithResult) override;
 	virtual void Finish(TEnumAsByte<EPawnActionResult::Type> WithResult) override;
+	virtual void Tick(float DeltaTime) override;
 	virtual FString GetDebugInfoString(int32 Depth) const;
+public:
+	virtual void ResetAction() override;
 //~ End UActionBrainComponentAction Interface
 
+protected:
 	bool PushNextActionCopy();
+
+	/** returns the reset copy of the action at the given index, making it on first use */
+	UActionBrainComponentAction* GetActionCopy(int32 Index);
 };
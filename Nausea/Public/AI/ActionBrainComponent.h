@@ -85,6 +85,16 @@ public:
 	UFUNCTION(BlueprintCallable, Category = ActionBrainComponent)
 	int32 AbortActionsInstigatedBy(UObject* const Instigator, TEnumAsByte<EAIRequestPriority::Type> Priority);
 
+	//Called by the UAIUpdateSchedulerSubsystem when this brain is given part of the frame's budget. DeltaTime is the time since this brain's last update.
+	//Also updates the controller's enemy selection and routine manager components.
+	void ScheduledTick(float DeltaTime);
+
+	bool ShouldUseUpdateScheduler() const { return bUseUpdateScheduler; }
+
+	//Used by the scheduler to keep brains that are fighting at full update rate.
+	UFUNCTION(BlueprintCallable, Category = ActionBrainComponent)
+	bool IsInCombat() const;
+
 protected:
 	UFUNCTION()
 	void OnPawnUpdated(ANauseaAIController* AIController, ACoreCharacter* Character);
@@ -92,10 +102,18 @@ protected:
 	void RemoveEventsForAction(UActionBrainComponentAction* Action);
 	void UpdateCurrentAction();
 
+	//Pushes an instance of DefaultActionClass when the brain has no action left to run. The instance never leaves the brain,
+	//so it is taken from the UActionPoolSubsystem through UActionBrainComponentAction::AcquireActionInstance and released back once popped.
+	void PushDefaultAction();
+
 protected:
 	UPROPERTY(EditDefaultsOnly, Category = ActionBrainComponent)
 	TSubclassOf<UActionBrainComponentAction> DefaultActionClass = nullptr;
 
+	//If true, this brain is registered to the UAIUpdateSchedulerSubsystem when its logic starts instead of ticking every frame. Opt-in per class since it changes the brain's update cadence.
+	UPROPERTY(EditDefaultsOnly, Category = ActionBrainComponent)
+	bool bUseUpdateScheduler = false;
+
 private:
 	UPROPERTY(Transient)
 	TArray<FActionStack> ActionStacks;
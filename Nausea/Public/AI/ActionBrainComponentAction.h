@@ -27,6 +27,7 @@ class NAUSEA_API UActionBrainComponentAction : public UObject
 	
 	friend UActionBrainComponent;
 	friend FActionStack;
+	friend class UActionPoolSubsystem;
 	
 //~ Begin UObject Interface
 public:
@@ -99,6 +100,19 @@ public:
 		return NewObject<TActionClass>(World, ActionClass);
 	}
 
+	//Takes an instance from the world's UActionPoolSubsystem (or creates one). The instance is returned to the pool when its owning brain pops it.
+	//Opt-in for instances a brain creates and runs itself without handing them to any caller (CreateActionInstance results are held by Blueprint graphs and routines and must never be pooled).
+	static UActionBrainComponentAction* AcquireActionInstance(UWorld* World, TSubclassOf<UActionBrainComponentAction> ActionClass);
+
+	/** returns this action to the state it had right after construction so that it can be pushed again.
+	 *	Must clear every reference and binding made while running (parent, child, owner, instigator, data object, message observers, OnActionFinished).
+	 *	Must not touch properties set from defaults or templates.
+	 *	@NOTE always call super. */
+	virtual void ResetAction();
+
+	FORCEINLINE bool IsPooled() const { return !!bPooled; }
+	FORCEINLINE bool ShouldReleaseToPool() const { return !!bReleaseToPool; }
+
 public:
 	UPROPERTY(BlueprintAssignable, Category = Action)
 	FActionFinishedSignature OnActionFinished;
@@ -256,6 +270,12 @@ private:
 	/** set to true when action fails the initial Start call */
 	uint32 bFailedToStart : 1;
 
+	/** set while this action is sitting in a UActionPoolSubsystem */
+	uint32 bPooled : 1;
+
+	/** set on instances made by AcquireActionInstance. The owning brain releases them to the pool once popped */
+	uint32 bReleaseToPool : 1;
+
 	UPROPERTY(Transient)
 	UActionBrainDataObject* ActionDataObject = nullptr;
 
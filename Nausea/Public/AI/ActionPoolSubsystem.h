@@ -0,0 +1,53 @@
+// Copyright 2020-2021 Jean-David Veilleux-Foppiano. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ActionPoolSubsystem.generated.h"
+
+class UActionBrainComponentAction;
+
+USTRUCT()
+struct FActionPoolList
+{
+	GENERATED_USTRUCT_BODY()
+
+	FActionPoolList() {}
+
+public:
+	UPROPERTY()
+	TArray<UActionBrainComponentAction*> ActionList;
+};
+
+/**
+ * Per-world pool of finished UActionBrainComponentAction instances, keyed by class.
+ * Only instances created through UActionBrainComponentAction::AcquireActionInstance are pooled (such as UActionBrainComponent's default action), they are released by their owning brain once popped from its stacks.
+ * Instances created through CreateActionInstance (used by the Blueprint facing factories such as CreateMoveToAction) or CreateAction may be kept by their creator and are never pooled.
+ */
+UCLASS()
+class NAUSEA_API UActionPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+//~ Begin USubsystem Interface
+public:
+	virtual void Deinitialize() override;
+//~ End USubsystem Interface
+
+public:
+	static UActionPoolSubsystem* Get(const UObject* WorldContextObject);
+
+	//Returns a reset pooled instance of the given class or creates a new one.
+	UActionBrainComponentAction* AcquireAction(TSubclassOf<UActionBrainComponentAction> ActionClass);
+
+	//Calls UActionBrainComponentAction::ResetAction and returns the action to the pool. Actions are left for garbage collection if their class' pool is full.
+	void ReleaseAction(UActionBrainComponentAction* Action);
+
+protected:
+	UPROPERTY(Transient)
+	TMap<UClass*, FActionPoolList> ActionPoolMap;
+
+	UPROPERTY(Transient)
+	int32 MaxPooledActionsPerClass = 128;
+};
@@ -0,0 +1,136 @@
+// Copyright 2020-2021 Jean-David Veilleux-Foppiano. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "GenericTeamAgentInterface.h"
+#include "AITargetSpatialHashSubsystem.generated.h"
+
+class UEnemySelectionComponent;
+
+USTRUCT()
+struct FAITargetEntry
+{
+	GENERATED_USTRUCT_BODY()
+
+	FAITargetEntry() {}
+
+	FAITargetEntry(AActor* InActor)
+		: Actor(InActor) {}
+
+public:
+	UPROPERTY()
+	TWeakObjectPtr<AActor> Actor = nullptr;
+	//Cached from the actor's IGenericTeamAgentInterface when the hash is rebuilt.
+	UPROPERTY()
+	FGenericTeamId TeamId = FGenericTeamId::NoTeam;
+	UPROPERTY()
+	FVector Location = FVector::ZeroVector;
+	//False if IAITargetInterface::IsTargetable returned false when the hash was rebuilt.
+	UPROPERTY()
+	bool bTargetable = true;
+};
+
+//Every target of a single team, bucketed by cell. Cells hold indices into UAITargetSpatialHashSubsystem::TargetList.
+USTRUCT()
+struct FAITargetTeamHash
+{
+	GENERATED_USTRUCT_BODY()
+
+	FAITargetTeamHash() {}
+
+public:
+	void Reset()
+	{
+		for (TPair<uint64, TArray<int32>>& Cell : CellMap)
+		{
+			Cell.Value.Reset();
+		}
+	}
+
+public:
+	TMap<uint64, TArray<int32>> CellMap;
+};
+
+//A candidate found for an enemy selection request along with the data scoring needs.
+struct FEnemySelectionCandidate
+{
+	FEnemySelectionCandidate() {}
+
+	FEnemySelectionCandidate(AActor* InActor, float InDistanceSquared)
+		: Actor(InActor), DistanceSquared(InDistanceSquared) {}
+
+	AActor* Actor = nullptr;
+	float DistanceSquared = 0.f;
+};
+
+/**
+ * World level 2D spatial hash of every registered IAITargetInterface actor, bucketed per team and rebuilt once per frame.
+ * Enemy selection components queue requests here instead of evaluating every potential target themselves. All requests made during a frame are resolved together after the rebuild:
+ * each requester only scores the hostile targets in the cells within its search radius.
+ */
+UCLASS(Config = Game)
+class NAUSEA_API UAITargetSpatialHashSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+//~ Begin USubsystem Interface
+public:
+	virtual void Deinitialize() override;
+//~ End USubsystem Interface
+
+//~ Begin FTickableGameObject Interface
+protected:
+	virtual void Tick(float DeltaTime) override;
+public:
+	virtual ETickableTickType GetTickableTickType() const { return ETickableTickType::Conditional; }
+	virtual bool IsTickable() const { return TargetList.Num() > 0 || PendingSelectionList.Num() > 0; }
+	virtual TStatId GetStatId() const { return TStatId(); }
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+//~ End FTickableGameObject Interface
+
+public:
+	static UAITargetSpatialHashSubsystem* Get(const UObject* WorldContextObject);
+
+	//Called by IAITargetInterface implementers when they begin and end play.
+	void RegisterTarget(AActor* Target);
+	void UnregisterTarget(AActor* Target);
+
+	//Gathers every targetable actor hostile to QuerierTeamId within Radius of Location, as of the last rebuild.
+	void QueryHostileTargets(const FVector& Location, float Radius, FGenericTeamId QuerierTeamId, TArray<FEnemySelectionCandidate>& OutCandidateList) const;
+
+	//Queues an enemy selection for the component. It is resolved with every other request during this subsystem's next tick.
+	void RequestEnemySelection(UEnemySelectionComponent* Requester);
+	void CancelEnemySelection(UEnemySelectionComponent* Requester);
+
+	uint64 GetCellKey(const FVector& Location) const
+	{
+		const int32 CellX = FMath::FloorToInt(Location.X / CellSize);
+		const int32 CellY = FMath::FloorToInt(Location.Y / CellSize);
+		return (uint64(uint32(CellX)) << 32) | uint64(uint32(CellY));
+	}
+
+protected:
+	void RebuildHash();
+	void ProcessEnemySelectionRequests();
+
+protected:
+	//Should be on the order of typical enemy search radii. Smaller cells mean fewer candidates per query but more cells visited.
+	UPROPERTY(Config)
+	float CellSize = 2000.f;
+
+	UPROPERTY(Transient)
+	TArray<FAITargetEntry> TargetList;
+
+	//Keyed by FGenericTeamId::GetId().
+	UPROPERTY(Transient)
+	TMap<uint8, FAITargetTeamHash> TeamHashMap;
+
+	UPROPERTY(Transient)
+	TArray<TWeakObjectPtr<UEnemySelectionComponent>> PendingSelectionList;
+
+	//Reused by every request of a batch.
+	TArray<FEnemySelectionCandidate> CandidateScratchList;
+};
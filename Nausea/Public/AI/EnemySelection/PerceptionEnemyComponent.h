@@ -25,6 +25,9 @@ protected:
 //~ Begin UEnemySelectionComponent Interface
 protected:
 	virtual AActor* FindBestEnemy() const override;
+public:
+	//Favours candidates that are in sight, then recently heard or recently damaging, using the perception component's summary.
+	virtual float ScoreEnemyCandidate(const FEnemySelectionCandidate& Candidate) const override;
 //~ End UEnemySelectionComponent Interface
 
 public:
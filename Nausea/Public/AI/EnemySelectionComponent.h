@@ -7,6 +7,7 @@
 #include "EnemySelectionComponent.generated.h"
 
 class IAITargetInterface;
+struct FEnemySelectionCandidate;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FEnemyChangedSignature, UEnemySelectionComponent*, EnemySelectionComponent, AActor*, NewEnemy, AActor*, PreviousEnemy);
 
@@ -40,6 +41,18 @@ public:
 
 	IAITargetInterface* GetEnemyInterface() const;
 
+	//Queues a batched enemy selection on the UAITargetSpatialHashSubsystem. The result is applied through OnEnemySelectionResolved.
+	UFUNCTION(BlueprintCallable, Category = EnemySelectionComponent)
+	void RequestEnemySelection();
+
+	//Scores a nearby hostile target during a batched selection. Higher is better, candidates scoring below zero are never selected.
+	virtual float ScoreEnemyCandidate(const FEnemySelectionCandidate& Candidate) const;
+
+	//Called by the UAITargetSpatialHashSubsystem with the best scoring candidate, or nullptr if none was found.
+	virtual void OnEnemySelectionResolved(AActor* BestEnemy);
+
+	float GetEnemySearchRadius() const { return EnemySearchRadius; }
+
 	//Attempts to set enemy to New Enemy. Returns false if fails.
 	//If nullptr is passed as New Enemy, will attempt to set enemy as result of FindBestEnemy() instead.
 	UFUNCTION(BlueprintCallable, Category = EnemySelectionComponent)
@@ -86,6 +99,10 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = EnemySelectionComponent, meta = (EditCondition = bEnemyChangeCooldown))
 	float EnemyChangeCooldown = 4.f;
 
+	//Radius around the pawn in which batched enemy selection looks for candidates.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = EnemySelectionComponent)
+	float EnemySearchRadius = 6000.f;
+
 private:
 	UPROPERTY()
 	ACoreCharacter* CurrentCharacter = nullptr;
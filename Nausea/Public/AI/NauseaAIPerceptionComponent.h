@@ -10,6 +10,28 @@ static FAISenseID AISenseSightID;
 static FAISenseID AISenseHearingID;
 static FAISenseID AISenseDamageID;
 
+//Compact perception state of a single actor, updated as stimuli are received so that queries never scan stimuli.
+struct FPerceptionSummaryEntry
+{
+	FPerceptionSummaryEntry() {}
+
+	FPerceptionSummaryEntry(AActor* InActor)
+		: Actor(InActor) {}
+
+	TWeakObjectPtr<AActor> Actor = nullptr;
+	FVector LastKnownLocation = FAISystem::InvalidLocation;
+
+	//World times of the most recent active stimulus of each sense. -1 if never received.
+	float LastSeenTime = -1.f;
+	float LastHeardTime = -1.f;
+	float LastDamagedTime = -1.f;
+
+	//True while the actor is in sight. LastSeenTime is kept up to date while this is set.
+	bool bCurrentlySeen = false;
+
+	float GetMostRecentStimulusTime() const { return FMath::Max3(bCurrentlySeen ? MAX_flt : LastSeenTime, LastHeardTime, LastDamagedTime); }
+};
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FGainedSightOfActorSignature, UNauseaAIPerceptionComponent*, PerceptionComponent, AActor*, Actor);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FLostSightOfActorSignature, UNauseaAIPerceptionComponent*, PerceptionComponent, AActor*, Actor);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FHeardNoiseFromActorSignature, UNauseaAIPerceptionComponent*, PerceptionComponent, AActor*, Actor);
@@ -44,6 +66,18 @@ public:
 
 	const FActorPerceptionInfo* GetActorPerceptionInfo(const AActor* Actor) const { return GetPerceptualData().Find(TObjectKey<AActor>(Actor)); }
 
+	//Returns the summary of the given actor, or nullptr if it has never been perceived (or has been forgotten).
+	const FPerceptionSummaryEntry* GetPerceptionSummary(const AActor* Actor) const
+	{
+		const int32* Index = PerceptionSummaryIndexMap.Find(TObjectKey<AActor>(Actor));
+		return Index ? &PerceptionSummaryList[*Index] : nullptr;
+	}
+
+	const TArray<FPerceptionSummaryEntry>& GetPerceptionSummaryList() const { return PerceptionSummaryList; }
+
+	UFUNCTION(BlueprintCallable, Category = Perception)
+	bool GetLastKnownLocation(AActor* Actor, FVector& Location) const;
+
 public:
 	UPROPERTY(BlueprintAssignable)
 	FGainedSightOfActorSignature OnGainedSightOfActor;
@@ -57,4 +91,15 @@ public:
 protected:
 	UFUNCTION()
 	virtual void OnPerceptionUpdate(AActor* Actor, FAIStimulus Stimulus);
+
+	UFUNCTION()
+	virtual void OnPerceptionForgotten(AActor* Actor);
+
+	FPerceptionSummaryEntry& FindOrAddPerceptionSummary(AActor* Actor);
+	//Swap removes the actor's summary.
+	void RemovePerceptionSummary(const AActor* Actor);
+
+protected:
+	TArray<FPerceptionSummaryEntry> PerceptionSummaryList;
+	TMap<TObjectKey<AActor>, int32> PerceptionSummaryIndexMap;
 };
\ No newline at end of file
@@ -29,6 +29,7 @@ class NAUSEA_API ACoreCharacter : public ACharacter, public IGenericTeamAgentInt
 //~ Begin AActor Interface
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 public:
 	virtual bool ReplicateSubobjects(class UActorChannel* Channel, class FOutBunch* Bunch, FReplicationFlags* RepFlags) override;
 	virtual void PostInitializeComponents() override;
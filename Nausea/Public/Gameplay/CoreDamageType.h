@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/DamageType.h"
+#include "Engine/StreamableManager.h"
 #include "Gameplay/StatusType.h"
 #include "CoreDamageType.generated.h"
 
@@ -27,6 +28,41 @@ enum class EApplicationResult : uint8
 	None //Event should not apply to target.
 };
 
+//Hard referenced entry of UCoreDamageType::StatusEffectMap, built once its classes are loaded.
+USTRUCT()
+struct FResolvedStatusEffectEntry
+{
+	GENERATED_USTRUCT_BODY()
+
+	FResolvedStatusEffectEntry() {}
+
+	FResolvedStatusEffectEntry(TSubclassOf<UStatusEffectBase> InStatusEffectClass, float InPower)
+		: StatusEffectClass(InStatusEffectClass), Power(InPower) {}
+
+public:
+	UPROPERTY()
+	TSubclassOf<UStatusEffectBase> StatusEffectClass = nullptr;
+	UPROPERTY()
+	float Power = 0.f;
+};
+
+USTRUCT()
+struct FGenericStatusEffectEntry
+{
+	GENERATED_USTRUCT_BODY()
+
+	FGenericStatusEffectEntry() {}
+
+	FGenericStatusEffectEntry(EStatusType InStatusType, float InPower)
+		: StatusType(InStatusType), Power(InPower) {}
+
+public:
+	UPROPERTY()
+	EStatusType StatusType = EStatusType::Invalid;
+	UPROPERTY()
+	float Power = 0.f;
+};
+
 /**
  * 
  */
@@ -34,6 +70,13 @@ UCLASS()
 class NAUSEA_API UCoreDamageType : public UDamageType
 {
 	GENERATED_UCLASS_BODY()
+
+//~ Begin UObject Interface
+public:
+	//On the class default object, requests the status effect class load so that damage types no weapon registers (character and AI ones) are loaded along with their class.
+	//Deferred to after engine initialization when the class default object is created during startup.
+	virtual void PostInitProperties() override;
+//~ End UObject Interface
 	
 public:
 	float GetDamageAmount() const { return DamageAmount; }
@@ -48,12 +91,30 @@ public:
 
 	const TMap<EStatusType, float>& GetGenericStatusEffectMap() const { return GenericStatusEffectMap; }
 
+	//Flat lists used on hit. The resolved list only contains classes that have finished loading and never triggers a load itself.
+	//If the load has not completed yet, the classes of StatusEffectMap already in memory are used.
+	const TArray<FResolvedStatusEffectEntry>& GetResolvedStatusEffectList() const;
+	const TArray<FGenericStatusEffectEntry>& GetGenericStatusEffectList() const { return GenericStatusEffectList; }
+	bool IsStatusEffectListResolved() const { return bStatusEffectListResolved; }
+
+	//Asynchronously loads every class in StatusEffectMap and then builds the resolved list. Called on the class default object when it is created and again when an owning weapon registers it. Does nothing if already requested.
+	void RequestStatusEffectClassLoad() const;
+
+	//Convenience for callers that only have the damage type class. Does nothing if the class is not a UCoreDamageType.
+	static void RequestStatusEffectClassLoad(TSubclassOf<UDamageType> DamageTypeClass);
+
 	EApplicationLogic GetDamageApplicationLogic() const { return DamageApplicationLogic; }
 	EApplicationLogic GetStatusApplicationLogic() const { return StatusApplicationLogic; }
 
 	EApplicationResult GetDamageApplicationResult(AActor* Instigator, AActor* Target) const;
 	EApplicationResult GetStatusApplicationResult(AActor* Instigator, AActor* Target) const;
 
+protected:
+	void OnStatusEffectClassesLoaded() const;
+
+	//Builds ResolvedStatusEffectList from the classes of StatusEffectMap that are already loaded (TSoftClassPtr::Get), without loading any.
+	void ResolveLoadedStatusEffectClasses() const;
+
 protected:
 	UPROPERTY(EditDefaultsOnly, Category = StatusEffect)
 	EApplicationLogic DamageApplicationLogic = EApplicationLogic::Enemy;
@@ -80,4 +141,15 @@ protected:
 	//Generic effect type and the power that will be applied on hit of this damage type. The specific effect class for this status type is dependent on the UStatusComponentConfigObject.
 	UPROPERTY(EditDefaultsOnly, Category = StatusEffect)
 	TMap<EStatusType, float> GenericStatusEffectMap;
+
+private:
+	//Built on the class default object, which is shared by every hit of this damage type.
+	UPROPERTY(Transient)
+	mutable TArray<FResolvedStatusEffectEntry> ResolvedStatusEffectList;
+	UPROPERTY(Transient)
+	mutable TArray<FGenericStatusEffectEntry> GenericStatusEffectList;
+	UPROPERTY(Transient)
+	mutable bool bStatusEffectListResolved = false;
+
+	mutable TSharedPtr<FStreamableHandle> StatusEffectStreamableHandle;
 };
@@ -0,0 +1,90 @@
+// Copyright 2020-2021 Jean-David Veilleux-Foppiano. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Gameplay/StatusType.h"
+
+enum class EDamageJournalEntryType : uint8
+{
+	Damage,
+	Status
+};
+
+//Fixed size record of a single damage or status application. Objects are stored by unique ID and name so that entries never keep anything alive.
+struct FDamageJournalEntry
+{
+	float WorldTime = 0.f;
+	double PlatformTime = 0.0;
+
+	uint32 InstigatorID = 0;
+	uint32 VictimID = 0;
+
+	FName InstigatorName = NAME_None;
+	FName VictimName = NAME_None;
+	FName DamageTypeName = NAME_None;
+	FName PartName = NAME_None;
+
+	//Amount received by ACoreGameState before any game state modification (friendly fire, etc.).
+	float RawAmount = 0.f;
+	//Amount after all game state modification.
+	float FinalAmount = 0.f;
+
+	EDamageJournalEntryType EntryType = EDamageJournalEntryType::Damage;
+	EStatusType StatusType = EStatusType::Invalid;
+};
+
+/**
+ * Preallocated ring buffer of the most recent damage and status applications that went through ACoreGameState.
+ * Recording never allocates and overwrites the oldest entry once full. Can be dumped to a compact binary file on demand.
+ */
+class NAUSEA_API FDamageJournal
+{
+public:
+	FDamageJournal() {}
+
+	//Allocates the buffer. Any previously recorded entry is discarded.
+	void Initialize(int32 InCapacity)
+	{
+		EntryBuffer.Reset();
+		EntryBuffer.SetNum(FMath::Max(InCapacity, 0));
+		HeadIndex = 0;
+		NumEntries = 0;
+	}
+
+	bool IsEnabled() const { return bEnabled && EntryBuffer.Num() > 0; }
+	void SetEnabled(bool bInEnabled) { bEnabled = bInEnabled; }
+
+	FDamageJournalEntry& AddEntry()
+	{
+		check(EntryBuffer.Num() > 0);
+		FDamageJournalEntry& Entry = EntryBuffer[HeadIndex];
+		HeadIndex = (HeadIndex + 1) % EntryBuffer.Num();
+		NumEntries = FMath::Min(NumEntries + 1, EntryBuffer.Num());
+		return Entry;
+	}
+
+	int32 Num() const { return NumEntries; }
+	int32 GetCapacity() const { return EntryBuffer.Num(); }
+
+	//Index 0 is the oldest recorded entry.
+	const FDamageJournalEntry& GetEntry(int32 Index) const
+	{
+		check(Index >= 0 && Index < NumEntries);
+		const int32 OldestIndex = NumEntries < EntryBuffer.Num() ? 0 : HeadIndex;
+		return EntryBuffer[(OldestIndex + Index) % EntryBuffer.Num()];
+	}
+
+	void Clear() { HeadIndex = 0; NumEntries = 0; }
+
+	//Writes the journal (oldest first) followed by the table of every name it references. Returns false if the file could not be written.
+	bool DumpToFile(const FString& Filename) const;
+
+	static const uint32 FileMagic = 0x4E444A31; //"NDJ1"
+
+protected:
+	TArray<FDamageJournalEntry> EntryBuffer;
+	int32 HeadIndex = 0;
+	int32 NumEntries = 0;
+	bool bEnabled = false;
+};
@@ -0,0 +1,158 @@
+// Copyright 2020-2021 Jean-David Veilleux-Foppiano. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "Engine/EngineTypes.h"
+#include "DamageQueueSubsystem.generated.h"
+
+class AActor;
+class AController;
+class UStatusComponent;
+
+UENUM()
+enum class EQueuedDamageEventType : uint8
+{
+	Generic,
+	Point,
+	Radial
+};
+
+//A single hit recorded for a UStatusComponent. The damage event itself is stored by value in one of FStatusDamageBatch's typed event lists.
+USTRUCT()
+struct FQueuedDamageEntry
+{
+	GENERATED_USTRUCT_BODY()
+
+	FQueuedDamageEntry() {}
+
+	FQueuedDamageEntry(float InDamageAmount, EQueuedDamageEventType InEventType, int32 InEventIndex, AController* InEventInstigator, AActor* InDamageCauser)
+		: DamageAmount(InDamageAmount), EventType(InEventType), EventIndex(InEventIndex), EventInstigator(InEventInstigator), DamageCauser(InDamageCauser) {}
+
+public:
+	UPROPERTY()
+	float DamageAmount = 0.f;
+	UPROPERTY()
+	EQueuedDamageEventType EventType = EQueuedDamageEventType::Generic;
+	UPROPERTY()
+	int32 EventIndex = INDEX_NONE;
+	UPROPERTY()
+	TWeakObjectPtr<AController> EventInstigator = nullptr;
+	UPROPERTY()
+	TWeakObjectPtr<AActor> DamageCauser = nullptr;
+};
+
+//All hits a UStatusComponent received in a frame. Lists are reset (not emptied) after every flush so that steady state queuing does not allocate.
+USTRUCT()
+struct FStatusDamageBatch
+{
+	GENERATED_USTRUCT_BODY()
+
+	FStatusDamageBatch() {}
+
+public:
+	void Add(float DamageAmount, FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser)
+	{
+		if (DamageEvent.IsOfType(FPointDamageEvent::ClassID))
+		{
+			const int32 EventIndex = PointDamageEventList.Add(static_cast<FPointDamageEvent const&>(DamageEvent));
+			EntryList.Emplace(DamageAmount, EQueuedDamageEventType::Point, EventIndex, EventInstigator, DamageCauser);
+		}
+		else if (DamageEvent.IsOfType(FRadialDamageEvent::ClassID))
+		{
+			const int32 EventIndex = RadialDamageEventList.Add(static_cast<FRadialDamageEvent const&>(DamageEvent));
+			EntryList.Emplace(DamageAmount, EQueuedDamageEventType::Radial, EventIndex, EventInstigator, DamageCauser);
+		}
+		else
+		{
+			const int32 EventIndex = DamageEventList.Add(DamageEvent);
+			EntryList.Emplace(DamageAmount, EQueuedDamageEventType::Generic, EventIndex, EventInstigator, DamageCauser);
+		}
+	}
+
+	FDamageEvent const& GetDamageEvent(const FQueuedDamageEntry& Entry) const
+	{
+		switch (Entry.EventType)
+		{
+		case EQueuedDamageEventType::Point:
+			return PointDamageEventList[Entry.EventIndex];
+		case EQueuedDamageEventType::Radial:
+			return RadialDamageEventList[Entry.EventIndex];
+		default:
+			break;
+		}
+
+		return DamageEventList[Entry.EventIndex];
+	}
+
+	int32 Num() const { return EntryList.Num(); }
+	bool IsEmpty() const { return EntryList.Num() == 0; }
+
+	void Reset()
+	{
+		EntryList.Reset();
+		DamageEventList.Reset();
+		PointDamageEventList.Reset();
+		RadialDamageEventList.Reset();
+	}
+
+public:
+	UPROPERTY()
+	TArray<FQueuedDamageEntry> EntryList;
+
+	UPROPERTY()
+	TArray<FDamageEvent> DamageEventList;
+	UPROPERTY()
+	TArray<FPointDamageEvent> PointDamageEventList;
+	UPROPERTY()
+	TArray<FRadialDamageEvent> RadialDamageEventList;
+};
+
+/**
+ * Per-world damage queue. UStatusComponents that batch their damage push their hits here and the queue resolves every pending component once per frame.
+ */
+UCLASS()
+class NAUSEA_API UDamageQueueSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+//~ Begin USubsystem Interface
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Deinitialize() override;
+//~ End USubsystem Interface
+
+//~ Begin FTickableGameObject Interface
+protected:
+	virtual void Tick(float DeltaTime) override { FlushDamageQueue(); }
+public:
+	virtual ETickableTickType GetTickableTickType() const { return ETickableTickType::Conditional; }
+	virtual bool IsTickable() const { return PendingStatusComponentList.Num() > 0; }
+	virtual TStatId GetStatId() const { return TStatId(); }
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+//~ End FTickableGameObject Interface
+
+public:
+	static UDamageQueueSubsystem* Get(const UObject* WorldContextObject);
+
+	//Records a hit against the given status component. The component is resolved on the next flush.
+	void QueueDamage(UStatusComponent* StatusComponent, float DamageAmount, FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser);
+
+	//Resolves every pending status component batch. Damage queued while flushing (death explosions, etc.) is resolved on the following flush.
+	void FlushDamageQueue();
+
+	bool IsFlushingDamageQueue() const { return bIsFlushingDamageQueue; }
+
+protected:
+	UPROPERTY(Transient)
+	TArray<TWeakObjectPtr<UStatusComponent>> PendingStatusComponentList;
+
+	//Swapped with PendingStatusComponentList when flushing so that both lists keep their allocations.
+	UPROPERTY(Transient)
+	TArray<TWeakObjectPtr<UStatusComponent>> FlushingStatusComponentList;
+
+	UPROPERTY(Transient)
+	bool bIsFlushingDamageQueue = false;
+};
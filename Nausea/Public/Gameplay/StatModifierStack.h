@@ -0,0 +1,180 @@
+// Copyright 2020-2021 Jean-David Veilleux-Foppiano. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StatModifierStack.generated.h"
+
+UENUM(BlueprintType)
+enum class EStatusEffectStatModifier : uint8
+{
+	MovementSpeed,
+	RotationRate,
+	DamageTaken,
+	DamageDealt,
+	StatusPowerTaken,
+	StatusPowerDealt,
+	ActionDisabled,
+	MAX UMETA(Hidden)
+};
+
+UENUM(BlueprintType)
+enum class EStatModifierStage : uint8
+{
+	Additive, //Summed and added to the base value.
+	Multiplicative, //Multiplied together and applied after additive modifiers.
+	Override //Replaces the result entirely. The most recently added override wins.
+};
+
+//Stats read as booleans (true when the evaluated value is greater than zero) from a base value of zero.
+FORCEINLINE bool IsBooleanStat(EStatusEffectStatModifier Stat) { return Stat == EStatusEffectStatModifier::ActionDisabled; }
+
+//Boolean stats start at zero, which no multiplier can change, so their modifiers are always summed regardless of the requested stage.
+FORCEINLINE EStatModifierStage GetEffectiveStatModifierStage(EStatusEffectStatModifier Stat, EStatModifierStage Stage) { return IsBooleanStat(Stat) ? EStatModifierStage::Additive : Stage; }
+
+USTRUCT(BlueprintType)
+struct FStatModifierHandle
+{
+	GENERATED_USTRUCT_BODY()
+
+	FStatModifierHandle() {}
+
+	FStatModifierHandle(int32 InModifierID)
+		: ModifierID(InModifierID) {}
+
+	bool operator== (const FStatModifierHandle& Other) const { return ModifierID == Other.ModifierID; }
+
+	bool IsValid() const { return ModifierID != INDEX_NONE; }
+	void Invalidate() { ModifierID = INDEX_NONE; }
+
+public:
+	UPROPERTY()
+	int32 ModifierID = INDEX_NONE;
+};
+
+USTRUCT()
+struct FStatModifierEntry
+{
+	GENERATED_USTRUCT_BODY()
+
+	FStatModifierEntry() {}
+
+	FStatModifierEntry(int32 InModifierID, EStatModifierStage InStage, float InValue)
+		: ModifierID(InModifierID), Stage(InStage), Value(InValue) {}
+
+public:
+	UPROPERTY()
+	int32 ModifierID = INDEX_NONE;
+	UPROPERTY()
+	EStatModifierStage Stage = EStatModifierStage::Multiplicative;
+	UPROPERTY()
+	float Value = 1.f;
+};
+
+//List of modifiers applied to a single stat. Stages are only recompiled when a modifier is added, changed or removed, otherwise evaluation uses the cached stage results.
+USTRUCT()
+struct FStatModifierStack
+{
+	GENERATED_USTRUCT_BODY()
+
+	FStatModifierStack() {}
+
+public:
+	FStatModifierHandle AddModifier(EStatModifierStage Stage, float Value)
+	{
+		const int32 ModifierID = NextModifierID++;
+		ModifierList.Emplace(ModifierID, Stage, Value);
+		MarkDirty();
+		return FStatModifierHandle(ModifierID);
+	}
+
+	bool SetModifier(const FStatModifierHandle& Handle, float Value)
+	{
+		FStatModifierEntry* Entry = ModifierList.FindByPredicate([&Handle](const FStatModifierEntry& Modifier) { return Modifier.ModifierID == Handle.ModifierID; });
+
+		if (!Entry)
+		{
+			return false;
+		}
+
+		if (Entry->Value != Value)
+		{
+			Entry->Value = Value;
+			MarkDirty();
+		}
+
+		return true;
+	}
+
+	bool RemoveModifier(const FStatModifierHandle& Handle)
+	{
+		//Overrides are resolved by order so removal needs to be stable.
+		if (ModifierList.RemoveAll([&Handle](const FStatModifierEntry& Modifier) { return Modifier.ModifierID == Handle.ModifierID; }) == 0)
+		{
+			return false;
+		}
+
+		MarkDirty();
+		return true;
+	}
+
+	float Evaluate(float BaseValue) const
+	{
+		if (bDirty)
+		{
+			Compile();
+		}
+
+		return bHasOverride ? CachedOverride : (BaseValue + CachedAdditive) * CachedMultiplicative;
+	}
+
+	bool IsEmpty() const { return ModifierList.Num() == 0; }
+
+	//Incremented every time the stack changes. Lets owners caching derived values know when to rebuild them.
+	uint32 GetRevision() const { return Revision; }
+
+protected:
+	void MarkDirty() { bDirty = true; Revision++; }
+
+	void Compile() const
+	{
+		CachedAdditive = 0.f;
+		CachedMultiplicative = 1.f;
+		bHasOverride = false;
+
+		for (const FStatModifierEntry& Modifier : ModifierList)
+		{
+			switch (Modifier.Stage)
+			{
+			case EStatModifierStage::Additive:
+				CachedAdditive += Modifier.Value;
+				break;
+			case EStatModifierStage::Multiplicative:
+				CachedMultiplicative *= Modifier.Value;
+				break;
+			case EStatModifierStage::Override:
+				bHasOverride = true;
+				CachedOverride = Modifier.Value;
+				break;
+			}
+		}
+
+		bDirty = false;
+	}
+
+protected:
+	UPROPERTY()
+	TArray<FStatModifierEntry> ModifierList;
+
+	UPROPERTY()
+	int32 NextModifierID = 0;
+
+	UPROPERTY()
+	uint32 Revision = 0;
+
+	mutable float CachedAdditive = 0.f;
+	mutable float CachedMultiplicative = 1.f;
+	mutable float CachedOverride = 0.f;
+	mutable bool bHasOverride = false;
+	mutable bool bDirty = false;
+};
@@ -4,10 +4,13 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "Net/Serialization/FastArraySerializer.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "GenericTeamAgentInterface.h"
 #include "Player/PlayerOwnershipInterfaceTypes.h"
 #include "StatusType.h"
+#include "Gameplay/DamageQueueSubsystem.h"
+#include "Gameplay/StatModifierStack.h"
 #include "StatusComponent.generated.h"
 
 class IStatusInterface;
@@ -18,6 +21,7 @@ class ANauseaPlayerState;
 class ACoreCharacter;
 class UDamageType;
 class UNauseaDamageType;
+class USkeletalMesh;
 
 //Helper struct for health and anything else that would want to be clamped between 0 and a specified maximum. 
 USTRUCT(BlueprintType)
@@ -124,6 +128,190 @@ public:
 	static FPartStatStruct InvalidPartStat;
 };
 
+//Replicated health of a single body part. Only the part's index, its quantized health percent and its max are sent, everything else is known by both sides through the UStatusComponentConfigObject.
+USTRUCT()
+struct FPartHealthItem : public FFastArraySerializerItem
+{
+	GENERATED_USTRUCT_BODY()
+
+	FPartHealthItem() {}
+
+	FPartHealthItem(uint8 InPartIndex)
+		: PartIndex(InPartIndex) {}
+
+public:
+	void PreReplicatedRemove(const struct FPartHealthArray& InArraySerializer);
+	void PostReplicatedAdd(const struct FPartHealthArray& InArraySerializer);
+	void PostReplicatedChange(const struct FPartHealthArray& InArraySerializer);
+
+	//Returns true if the quantized values changed.
+	bool SetValue(float InValue, float InMaxValue)
+	{
+		const float NewMaxValue = FMath::Max(InMaxValue, 0.f);
+		const uint16 NewPercentValue = InMaxValue > 0.f ? uint16(FMath::RoundToInt(FMath::Clamp(InValue / InMaxValue, 0.f, 1.f) * float(MAX_uint16))) : 0;
+
+		if (NewMaxValue == MaxValue && NewPercentValue == PercentValue)
+		{
+			return false;
+		}
+
+		MaxValue = NewMaxValue;
+		PercentValue = NewPercentValue;
+		return true;
+	}
+
+	float GetMaxValue() const { return MaxValue; }
+	float GetValue() const { return (float(PercentValue) / float(MAX_uint16)) * GetMaxValue(); }
+
+public:
+	UPROPERTY()
+	uint8 PartIndex = 0;
+	//Health as a fraction of MaxValue, in 1/65535ths.
+	UPROPERTY()
+	uint16 PercentValue = 0;
+	//Kept unquantized since scaled part health maxes are fractional. Rarely changes, so it costs little to send.
+	UPROPERTY()
+	float MaxValue = 0.f;
+};
+
+USTRUCT()
+struct FPartHealthArray : public FFastArraySerializer
+{
+	GENERATED_USTRUCT_BODY()
+
+	FPartHealthArray() {}
+
+public:
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FPartHealthItem, FPartHealthArray>(PartHealthItems, DeltaParms, *this);
+	}
+
+	UStatusComponent* GetOwningStatusComponent() const { return OwningStatusComponent; }
+
+public:
+	UPROPERTY()
+	TArray<FPartHealthItem> PartHealthItems;
+
+	UPROPERTY(NotReplicated)
+	UStatusComponent* OwningStatusComponent = nullptr;
+};
+
+template<>
+struct TStructOpsTypeTraits<FPartHealthArray> : public TStructOpsTypeTraitsBase2<FPartHealthArray>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
+
+//Replicated entry of a UStatusComponent's status effect list. Effect subobjects can arrive after the item itself so additions are only reported once the pointer is mapped.
+USTRUCT()
+struct FStatusEffectItem : public FFastArraySerializerItem
+{
+	GENERATED_USTRUCT_BODY()
+
+	FStatusEffectItem() {}
+
+	FStatusEffectItem(UStatusEffectBase* InStatusEffect)
+		: StatusEffect(InStatusEffect) {}
+
+public:
+	void PreReplicatedRemove(const struct FStatusEffectArray& InArraySerializer);
+	void PostReplicatedAdd(const struct FStatusEffectArray& InArraySerializer);
+	void PostReplicatedChange(const struct FStatusEffectArray& InArraySerializer);
+
+public:
+	UPROPERTY()
+	UStatusEffectBase* StatusEffect = nullptr;
+
+	//Local only. The effect the owning component was last notified of for this item.
+	UPROPERTY(NotReplicated)
+	TWeakObjectPtr<UStatusEffectBase> NotifiedStatusEffect = nullptr;
+};
+
+USTRUCT()
+struct FStatusEffectArray : public FFastArraySerializer
+{
+	GENERATED_USTRUCT_BODY()
+
+	FStatusEffectArray() {}
+
+public:
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FStatusEffectItem, FStatusEffectArray>(StatusEffectItems, DeltaParms, *this);
+	}
+
+	UStatusComponent* GetOwningStatusComponent() const { return OwningStatusComponent; }
+
+	void AddStatusEffect(UStatusEffectBase* StatusEffect)
+	{
+		MarkItemDirty(StatusEffectItems.Emplace_GetRef(StatusEffect));
+	}
+
+	bool RemoveStatusEffect(UStatusEffectBase* StatusEffect)
+	{
+		const int32 Index = StatusEffectItems.IndexOfByPredicate([StatusEffect](const FStatusEffectItem& Item) { return Item.StatusEffect == StatusEffect; });
+
+		if (Index == INDEX_NONE)
+		{
+			return false;
+		}
+
+		StatusEffectItems.RemoveAtSwap(Index, 1, false);
+		MarkArrayDirty();
+		return true;
+	}
+
+public:
+	UPROPERTY()
+	TArray<FStatusEffectItem> StatusEffectItems;
+
+	UPROPERTY(NotReplicated)
+	UStatusComponent* OwningStatusComponent = nullptr;
+};
+
+template<>
+struct TStructOpsTypeTraits<FStatusEffectArray> : public TStructOpsTypeTraitsBase2<FStatusEffectArray>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
+
+//Bone to body part lookup compiled once per skeletal mesh and UStatusComponentConfigObject class, then shared by every status component using that pair.
+struct FBodyPartLookupTable
+{
+	static constexpr uint8 InvalidPartIndex = MAX_uint8;
+
+	int32 GetPartIndex(int32 BoneIndex) const
+	{
+		if (!BonePartIndexList.IsValidIndex(BoneIndex) || BonePartIndexList[BoneIndex] == InvalidPartIndex)
+		{
+			return INDEX_NONE;
+		}
+
+		return BonePartIndexList[BoneIndex];
+	}
+
+	int32 GetPartIndex(const FName& BoneName) const
+	{
+		const uint8* PartIndex = BoneNamePartIndexMap.Find(BoneName);
+		return PartIndex ? int32(*PartIndex) : INDEX_NONE;
+	}
+
+public:
+	//Indexed by the skeletal mesh's reference bone index (the index space of FBodyInstance::InstanceBoneIndex). Meshes sharing a skeleton may order or strip bones differently so tables are never shared across meshes.
+	//Empty if the table was compiled without a mesh.
+	TArray<uint8> BonePartIndexList;
+
+	//Used by name based queries (blueprint, owners without a skeletal mesh).
+	TMap<FName, uint8> BoneNamePartIndexMap;
+};
+
 USTRUCT(BlueprintType)
 struct FDeathEvent
 {
@@ -165,11 +353,18 @@ class NAUSEA_API UStatusComponent : public UActorComponent, public IGenericTeamA
 
 	//Configuration will perform the initialization so it needs access to all the internals of this class.
 	friend class UStatusComponentConfigObject;
+	//Damage queue resolves this component's pending damage batch.
+	friend class UDamageQueueSubsystem;
+	//Replicated part health items notify this component directly.
+	friend struct FPartHealthItem;
+	friend struct FStatusEffectItem;
 
 //~ Begin UActorComponent Interface 
 protected:
 	virtual void InitializeComponent() override;
 	virtual void BeginPlay() override;
+	//Releases the owner's bucket in the UStatusEffectPoolSubsystem.
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 public:
 	virtual bool ReplicateSubobjects(class UActorChannel* Channel, class FOutBunch* Bunch, FReplicationFlags* RepFlags) override;
 //~ End UActorComponent Interface
@@ -233,6 +428,13 @@ public:
 	UFUNCTION()
 	int32 GetPartHealthIndexForBone(const FName& BoneName) const;
 
+	//Preferred over the name based lookups when the hit bone index is known (see FBodyInstance::InstanceBoneIndex).
+	int32 GetPartHealthIndexForBoneIndex(int32 BoneIndex) const { return BodyPartLookupTable.IsValid() ? BodyPartLookupTable->GetPartIndex(BoneIndex) : INDEX_NONE; }
+
+	//If true, hits are queued on the UDamageQueueSubsystem and resolved together at the end of the frame instead of on receipt.
+	UFUNCTION(BlueprintCallable, Category = StatusComponent)
+	bool ShouldBatchDamage() const { return bBatchDamage; }
+
 	void RequestMovementSpeedUpdate() { bUpdateMovementSpeedModifier = true; }
 	void RequestRotationRateUpdate() { bUpdateRotationRateModifier = true; }
 
@@ -263,6 +465,14 @@ public:
 	
 //Status effect hooks.
 public:
+	//Context free modifiers (such as UStatusEffectBase::StatusModificationMap entries) live in these stacks and are only recompiled when one of them changes.
+	FStatModifierStack& GetStatModifierStack(EStatusEffectStatModifier Stat) { return StatModifierStackList[uint8(Stat)]; }
+	const FStatModifierStack& GetStatModifierStack(EStatusEffectStatModifier Stat) const { return StatModifierStackList[uint8(Stat)]; }
+
+	//Evaluates the given stat's modifier stack. Boolean stats are considered true if the result is greater than zero.
+	float ProcessStatModifier(EStatusEffectStatModifier Stat, float BaseValue) const { return GetStatModifierStack(Stat).Evaluate(BaseValue); }
+
+	//The events below are reserved for modifiers that depend on the damage event or instigator. They are only broadcast when bound.
 	DECLARE_EVENT_TwoParams(UStatusComponent, FStatusComponentValueModifierSignature, const UStatusComponent*, float&)
 	FStatusComponentValueModifierSignature OnProcessMovementSpeed;
 	FStatusComponentValueModifierSignature OnProcessRotationRate;
@@ -302,6 +512,12 @@ protected:
 
 	virtual void HandleDamageTypeStatus(float Damage, struct FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser);
 
+	//Resolves all hits queued for this component in a single pass. Stops applying damage as soon as the owner dies.
+	virtual void ProcessDamageBatch(FStatusDamageBatch& DamageBatch);
+	//Evaluates the DamageTaken stat modifier stack once for the whole batch, then broadcasts OnProcessDamageTaken for each hit with that hit's own damage event
+	//since those handlers depend on the event (bone, hit location, etc.) and may clamp or offset per hit.
+	virtual void ProcessDamageBatchModifiers(FStatusDamageBatch& DamageBatch);
+
 	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = StatusComponent)
 	virtual UStatusEffectBase* AddStatusEffect(TSubclassOf<UStatusEffectBase> StatusEffectClass, struct FDamageEvent const& DamageEvent, AController* EventInstigator, float Power = -1.f);
 
@@ -313,16 +529,18 @@ protected:
 
 	UFUNCTION()
 	virtual void OnRep_Health();
-	UFUNCTION()
-	virtual void OnRep_PartHealthList();
+	//Updates PartHealthList from its replicated item and broadcasts OnPartHealthChanged if needed.
+	virtual void OnPartHealthReplicated(const FPartHealthItem& PartHealthItem);
+	//Copies a part's health into its replicated item and marks it dirty if its quantized value changed.
+	void MarkPartHealthDirty(int32 PartIndex);
 
 	UFUNCTION()
 	virtual void OnRep_Armour();
 
-	UFUNCTION()
-	virtual void OnRep_ReplicatedStatusEffectList();
-	UFUNCTION()
-	void OnRep_ReplicatedStatusListUpdateCounter();
+	//Client callbacks from ReplicatedStatusEffectList. Only the affected entry is ever passed.
+	virtual void OnReplicatedStatusEffectAdded(UStatusEffectBase* StatusEffect);
+	virtual void OnReplicatedStatusEffectRemoved(UStatusEffectBase* StatusEffect);
+	virtual void OnReplicatedStatusEffectChanged(UStatusEffectBase* StatusEffect);
 
 	UFUNCTION()
 	virtual void OnRep_TeamId();
@@ -339,14 +557,15 @@ protected:
 	FStatStruct PreviousHealth;
 
 
-	UPROPERTY(ReplicatedUsing = OnRep_PartHealthList)
+	//Not replicated. Both the server and clients build this from StatusConfig, and health changes are sent through ReplicatedPartHealth.
+	UPROPERTY(Transient)
 	TArray<FPartStatStruct> PartHealthList;
 
-	UPROPERTY(Transient)
-	TArray<FPartStatStruct> PreviousPartHealthList;
+	UPROPERTY(Transient, Replicated)
+	FPartHealthArray ReplicatedPartHealth;
 
-	UPROPERTY(Transient)
-	TMap<FName, int32> BonePartIndexMap;
+	//Shared with every other component using the same skeletal mesh and StatusConfig.
+	TSharedPtr<const FBodyPartLookupTable> BodyPartLookupTable = nullptr;
 	
 
 	UPROPERTY(Transient, ReplicatedUsing = OnRep_Armour)
@@ -358,13 +577,8 @@ protected:
 	UPROPERTY(Transient, Replicated)
 	FVector2D ArmourDecay = FVector2D(0.667f, 0.333f);
 
-	UPROPERTY(ReplicatedUsing = OnRep_ReplicatedStatusEffectList)
-	TArray<UStatusEffectBase*> ReplicatedStatusEffectList;
-	UPROPERTY()
-	TArray<TWeakObjectPtr<UStatusEffectBase>> PreviousReplicatedStatusEffectList;
-
-	UPROPERTY(ReplicatedUsing = OnRep_ReplicatedStatusListUpdateCounter)
-	uint8 ReplicatedStatusListUpdateCounter = 0;
+	UPROPERTY(Replicated)
+	FStatusEffectArray ReplicatedStatusEffectList;
 
 	UPROPERTY()
 	TMap<EStatusType, TSubclassOf<UStatusEffectBase>> GenericStatusEffectMap;
@@ -372,6 +586,15 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = StatusComponent)
 	TSubclassOf<UStatusComponentConfigObject> StatusConfig;
 
+	//When enabled, damage is only applied at the end of the frame. TakeDamage then returns the amount queued rather than the amount applied,
+	//and health/death checks made in the same frame do not see the queued hits yet. Only enable for actors whose callers do not rely on either (e.g. horde AI).
+	UPROPERTY(EditDefaultsOnly, Category = StatusComponent)
+	bool bBatchDamage = false;
+
+	//Hits received this frame that have yet to be resolved by the UDamageQueueSubsystem.
+	UPROPERTY(Transient)
+	FStatusDamageBatch PendingDamageBatch;
+
 	//Internal property.
 	UPROPERTY()
 	bool bHideStatusComponentTeam = false;
@@ -388,6 +611,9 @@ protected:
 	UPROPERTY(Transient)
 	bool bInitializeOnBeginPlay = true;
 
+	//Indexed by EStatusEffectStatModifier.
+	FStatModifierStack StatModifierStackList[uint8(EStatusEffectStatModifier::MAX)];
+
 	UPROPERTY(Transient)
 	mutable float CachedMovementSpeedModifier = 1.f;
 	UPROPERTY(Transient)
@@ -412,6 +638,13 @@ class NAUSEA_API UStatusComponentConfigObject : public UObject
 public:
 	virtual void ConfigureStatusComponent(UStatusComponent* StatusComponent) const;
 
+	//Returns this configuration's body part lookup for the given skeletal mesh, compiling it on first request. Should be called on the class default object.
+	TSharedPtr<const FBodyPartLookupTable> GetBodyPartLookupTable(const USkeletalMesh* SkeletalMesh) const;
+
+protected:
+	//Resolves bone names against the mesh's own reference skeleton, not the USkeleton's.
+	TSharedPtr<const FBodyPartLookupTable> CompileBodyPartLookupTable(const USkeletalMesh* SkeletalMesh) const;
+
 protected:
 	UPROPERTY(EditDefaultsOnly, Category = Basic)
 	FStatStruct Health = FStatStruct(100.f, 100.f);
@@ -430,4 +663,8 @@ protected:
 	
 	UPROPERTY(EditDefaultsOnly, Category = Status)
 	TMap<EStatusType, TSubclassOf<UStatusEffectBase>> GenericStatusEffectMap;
+
+private:
+	//Compiled lookup tables per skeletal mesh. A null mesh key holds the name only table.
+	mutable TMap<TWeakObjectPtr<const USkeletalMesh>, TSharedPtr<const FBodyPartLookupTable>> BodyPartLookupTableMap;
 };
\ No newline at end of file
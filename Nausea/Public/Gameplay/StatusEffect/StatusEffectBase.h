@@ -3,8 +3,8 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "Tickable.h"
 #include "Gameplay/StatusType.h"
+#include "Gameplay/StatModifierStack.h"
 #include "Player/PlayerClass/PlayerClassTypes.h"
 #include "StatusEffectBase.generated.h"
 
@@ -19,18 +19,6 @@ enum class EBasicStatusEffectType : uint8
 	Cumulative
 };
 
-UENUM(BlueprintType)
-enum class EStatusEffectStatModifier : uint8
-{
-	MovementSpeed,
-	RotationRate,
-	DamageTaken,
-	DamageDealt,
-	StatusPowerTaken,
-	StatusPowerDealt,
-	ActionDisabled
-};
-
 USTRUCT(BlueprintType)
 struct FStatusEffectDelegateEntry
 {
@@ -39,8 +27,12 @@ struct FStatusEffectDelegateEntry
 	FStatusEffectDelegateEntry() {}
 
 public:
-	FDelegateHandle StatusEffectDelegate;
 	UPROPERTY()
+	FStatModifierHandle ModifierHandle;
+	//Stage this modifier is evaluated in. Ignored for boolean stats, which are always additive (see GetEffectiveStatModifierStage).
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+	EStatModifierStage Stage = EStatModifierStage::Multiplicative;
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
 	float Value = -1.f;
 };
 
@@ -54,6 +46,8 @@ class NAUSEA_API UStatusEffectBase : public UObject
 {
 	GENERATED_UCLASS_BODY()
 
+	friend class UStatusEffectPoolSubsystem;
+
 //~ Begin UObject Interface
 public:
 	virtual void PostInitProperties() override;
@@ -72,6 +66,11 @@ public:
 
 	virtual void OnDestroyed();
 
+	//Returns this effect to its pre-Initialize state so the UStatusEffectPoolSubsystem can hand it out again.
+	//Must not reset RefreshCounter. It keeps counting across reuses so that clients holding the same replicated instance still receive OnRep_RefreshCounter.
+	virtual void ResetStatusEffect();
+	bool IsPooled() const { return bIsPooled; }
+
 	virtual bool CanActivateStatus(ANauseaPlayerState* Instigator, float Power) const;
 	virtual bool CanRefreshStatus(ANauseaPlayerState* Instigator, float Power) const;
 
@@ -106,7 +105,7 @@ public:
 	virtual float GetStatusEffectProgress() const { return -1.f; }
 
 	UFUNCTION(BlueprintCallable, Category = StatusEffect)
-	void SetStatModifier(EStatusEffectStatModifier Stat, float InModifier);
+	void SetStatModifier(EStatusEffectStatModifier Stat, float InModifier, EStatModifierStage Stage = EStatModifierStage::Multiplicative);
 
 	UFUNCTION(BlueprintCallable, Category = StatusEffect)
 	float GetStatModifier(EStatusEffectStatModifier Stat) const;
@@ -135,6 +134,7 @@ protected:
 	UFUNCTION(BlueprintImplementableEvent, Category = StatusEffect, meta=(DisplayName="On Power Changed",ScriptName="OnPowerChanged"))
 	void K2_OnPowerChanged(float Power);
 
+	//Adds the entry to the owner's stat stack using GetEffectiveStatModifierStage, so boolean stats such as ActionDisabled are always added to rather than multiplied.
 	void BindStatModifier(EStatusEffectStatModifier Stat, FStatusEffectDelegateEntry& StatusEffectModifierEntry);
 	void UpdateStatModifier(EStatusEffectStatModifier Stat);
 	void UnbindStatModifier(EStatusEffectStatModifier Stat, FStatusEffectDelegateEntry& StatusEffectModifierEntry);
@@ -162,7 +162,8 @@ protected:
 	UPROPERTY(ReplicatedUsing = OnRep_RefreshCounter)
 	uint8 RefreshCounter = 0;
 
-	UPROPERTY()
+	//Modifiers applied while this effect is active. Entries authored here are bound on activation, SetStatModifier adds or updates entries at runtime.
+	UPROPERTY(EditDefaultsOnly, Category = StatusEffect)
 	TMap<EStatusEffectStatModifier, FStatusEffectDelegateEntry> StatusModificationMap;
 
 private:
@@ -173,6 +174,9 @@ private:
 
 	UPROPERTY()
 	UStatusComponent* OwningStatusComponent = nullptr;
+
+	UPROPERTY(Transient)
+	bool bIsPooled = false;
 };
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FStatusTimeUpdateSignature, UStatusEffectBase*, StatusEffect, float, StatusStartTime, float, StatusEndTime);
@@ -182,10 +186,13 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FPowerUpdateSignature, UStatusEffec
  * 
  */
 UCLASS()
-class NAUSEA_API UStatusEffectBasic : public UStatusEffectBase, public FTickableGameObject
+class NAUSEA_API UStatusEffectBasic : public UStatusEffectBase
 {
 	GENERATED_UCLASS_BODY()
 
+	//Timing (expiry and power decay) of this effect is owned by the status effect manager.
+	friend class UStatusEffectManagerSubsystem;
+
 //~ Begin UObject Interface
 public:
 	virtual void PostInitProperties() override;
@@ -196,6 +203,7 @@ public:
 public:
 	virtual void Initialize(UStatusComponent* StatusComponent, ANauseaPlayerState* Instigator, float Power) override;
 	virtual void OnDestroyed() override;
+	virtual void ResetStatusEffect() override;
 	virtual void OnActivated(EStatusBeginType BeginType) override;
 	virtual void OnDeactivated(EStatusEndType EndType) override;
 	virtual bool CanActivateStatus(ANauseaPlayerState* Instigator, float Power) const override;
@@ -203,16 +211,6 @@ public:
 	virtual void AddEffectPower(ANauseaPlayerState* Instigator, float Power) override;
 //~ End UStatusEffectBase Interface
 
-//~ Begin FTickableGameObject Interface
-protected:
-	virtual void Tick(float DeltaTime) override;
-public:
-	virtual ETickableTickType GetTickableTickType() const { return TickType; }
-	virtual bool IsTickable() const { return bTickEnabled && !IsPendingKill(); }
-	virtual TStatId GetStatId() const { return TStatId(); }
-	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
-//~ End FTickableGameObject Interface
-
 public:
 	UFUNCTION(BlueprintCallable, Category = StatusEffect)
 	float GetPowerRequirement() const { return EffectPowerRange.X; }
@@ -260,13 +258,15 @@ protected:
 	UFUNCTION(BlueprintImplementableEvent, Category = StatusEffect)
 	void OnCriticalPointReached(bool bReached);
 
+	//Called by the UStatusEffectManagerSubsystem when StatusTime's end has been reached.
+	virtual void OnStatusTimeExpired();
+	//Called by the UStatusEffectManagerSubsystem on every power decay step with the decayed power.
+	virtual void OnPowerDecayStep(float DecayedPower);
+
 protected:
 	UPROPERTY(ReplicatedUsing = OnRep_StatusTime)
 	FVector2D StatusTime = -1.f;
 
-	UPROPERTY()
-	FTimerHandle StatusTimer;
-
 	UPROPERTY(ReplicatedUsing = OnRep_CurrentPower)
 	float CurrentPower = -1.f;
 
@@ -289,12 +289,8 @@ protected:
 	UPROPERTY(EditDefaultsOnly)
 	float PowerDecayRate = 0.f;
 
-	UPROPERTY()
-	FTimerHandle PowerDecayTimer;
-
-	UPROPERTY(Transient)
-	bool bTickEnabled = false;
-
 private:
-	ETickableTickType TickType = ETickableTickType::Never;
+	//Index of this effect's entry in the UStatusEffectManagerSubsystem's timing list for its class and type.
+	UPROPERTY(Transient)
+	int32 StatusEffectTimingIndex = INDEX_NONE;
 };
\ No newline at end of file
@@ -0,0 +1,151 @@
+// Copyright 2020-2021 Jean-David Veilleux-Foppiano. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "Gameplay/StatusEffect/StatusEffectBase.h"
+#include "StatusEffectManagerSubsystem.generated.h"
+
+//Effect timing lists are grouped by effect class and basic effect type so that effects that behave the same are stepped together.
+USTRUCT()
+struct FStatusEffectTimingKey
+{
+	GENERATED_USTRUCT_BODY()
+
+	FStatusEffectTimingKey() {}
+
+	FStatusEffectTimingKey(const UStatusEffectBasic* StatusEffect)
+		: StatusEffectClass(StatusEffect ? StatusEffect->GetClass() : nullptr), StatusEffectType(StatusEffect ? StatusEffect->GetStatusEffectType() : EBasicStatusEffectType::Instant) {}
+
+	bool operator== (const FStatusEffectTimingKey& Other) const { return StatusEffectClass == Other.StatusEffectClass && StatusEffectType == Other.StatusEffectType; }
+
+	friend uint32 GetTypeHash(const FStatusEffectTimingKey& Key) { return HashCombine(GetTypeHash(Key.StatusEffectClass), uint32(Key.StatusEffectType)); }
+
+public:
+	UPROPERTY()
+	UClass* StatusEffectClass = nullptr;
+	UPROPERTY()
+	EBasicStatusEffectType StatusEffectType = EBasicStatusEffectType::Instant;
+};
+
+//Timing state of a single UStatusEffectBasic. All times are world times. Power is evaluated in closed form from DecayStartPower and PowerDecayRate.
+USTRUCT()
+struct FStatusEffectTimingEntry
+{
+	GENERATED_USTRUCT_BODY()
+
+	FStatusEffectTimingEntry() {}
+
+public:
+	float GetPowerAtTime(float WorldTime) const
+	{
+		if (PowerDecayRate <= 0.f || DecayStartTime < 0.f || WorldTime <= DecayStartTime)
+		{
+			return DecayStartPower;
+		}
+
+		return FMath::Max(DecayStartPower - ((WorldTime - DecayStartTime) * PowerDecayRate), 0.f);
+	}
+
+	//Returns the next world time at which this entry's owner needs to be notified.
+	float GetNextWakeTime() const
+	{
+		if (EndTime < 0.f)
+		{
+			return NextDecayStepTime;
+		}
+
+		return NextDecayStepTime < 0.f ? EndTime : FMath::Min(EndTime, NextDecayStepTime);
+	}
+
+public:
+	UPROPERTY()
+	TWeakObjectPtr<UStatusEffectBasic> StatusEffect = nullptr;
+
+	//World time at which the effect expires. -1 if it does not expire on its own.
+	UPROPERTY()
+	float EndTime = -1.f;
+
+	UPROPERTY()
+	float DecayStartTime = -1.f;
+	UPROPERTY()
+	float DecayStartPower = 0.f;
+	UPROPERTY()
+	float PowerDecayRate = 0.f;
+	//World time of the next decay step notification. -1 if power is not decaying.
+	UPROPERTY()
+	float NextDecayStepTime = -1.f;
+};
+
+USTRUCT()
+struct FStatusEffectTimingList
+{
+	GENERATED_USTRUCT_BODY()
+
+	FStatusEffectTimingList() {}
+
+public:
+	UPROPERTY()
+	TArray<FStatusEffectTimingEntry> EntryList;
+};
+
+/**
+ * Owns the timing (expiry and power decay) of every UStatusEffectBasic in the world. Effects are only notified when their state changes.
+ */
+UCLASS(Config = Game)
+class NAUSEA_API UStatusEffectManagerSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+//~ Begin USubsystem Interface
+public:
+	virtual void Deinitialize() override;
+//~ End USubsystem Interface
+
+//~ Begin FTickableGameObject Interface
+protected:
+	virtual void Tick(float DeltaTime) override;
+public:
+	virtual ETickableTickType GetTickableTickType() const { return ETickableTickType::Conditional; }
+	virtual bool IsTickable() const { return NumRegisteredStatusEffects > 0; }
+	virtual TStatId GetStatId() const { return TStatId(); }
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+//~ End FTickableGameObject Interface
+
+public:
+	static UStatusEffectManagerSubsystem* Get(const UObject* WorldContextObject);
+
+	//Begins tracking timing for the given effect. Stores the effect's entry index in UStatusEffectBasic::StatusEffectTimingIndex.
+	void RegisterStatusEffect(UStatusEffectBasic* StatusEffect);
+	void UnregisterStatusEffect(UStatusEffectBasic* StatusEffect);
+
+	//Pushes a new expiry time to the manager. Called on activation and refresh.
+	void SetStatusEffectEndTime(UStatusEffectBasic* StatusEffect, float EndTime);
+	//Pushes a new power decay curve to the manager. Called whenever the effect's power is changed by something other than decay.
+	void SetStatusEffectPowerDecay(UStatusEffectBasic* StatusEffect, float Power, float DecayStartTime, float PowerDecayRate);
+
+	float GetStatusEffectPower(const UStatusEffectBasic* StatusEffect) const;
+
+protected:
+	FStatusEffectTimingEntry* GetTimingEntry(const UStatusEffectBasic* StatusEffect);
+	const FStatusEffectTimingEntry* GetTimingEntry(const UStatusEffectBasic* StatusEffect) const;
+
+	void UpdateNextWakeTime(float InWakeTime) { NextWakeTime = NextWakeTime < 0.f ? InWakeTime : FMath::Min(NextWakeTime, InWakeTime); }
+
+protected:
+	UPROPERTY(Transient)
+	TMap<FStatusEffectTimingKey, FStatusEffectTimingList> StatusEffectTimingMap;
+
+	UPROPERTY(Transient)
+	int32 NumRegisteredStatusEffects = 0;
+
+	//Earliest wake time of all entries. Tick does not walk any list before this time is reached.
+	UPROPERTY(Transient)
+	float NextWakeTime = -1.f;
+
+	//Interval at which decaying effects are notified of their new power.
+	UPROPERTY(Config)
+	float PowerDecayStepInterval = 0.1f;
+};
@@ -0,0 +1,75 @@
+// Copyright 2020-2021 Jean-David Veilleux-Foppiano. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "StatusEffectPoolSubsystem.generated.h"
+
+class AActor;
+class UStatusComponent;
+class UStatusEffectBase;
+
+USTRUCT()
+struct FStatusEffectPoolList
+{
+	GENERATED_USTRUCT_BODY()
+
+	FStatusEffectPoolList() {}
+
+public:
+	UPROPERTY()
+	TArray<UStatusEffectBase*> StatusEffectList;
+};
+
+//Every pooled effect created for a single actor, keyed by class.
+USTRUCT()
+struct FStatusEffectActorPool
+{
+	GENERATED_USTRUCT_BODY()
+
+	FStatusEffectActorPool() {}
+
+public:
+	UPROPERTY()
+	TMap<UClass*, FStatusEffectPoolList> StatusEffectPoolMap;
+};
+
+/**
+ * Per-world pool of expired status effect instances, keyed by the actor they were created for and then by class. Only used by the authority, clients receive their instances through replication.
+ * A replicated instance keeps its network identity for as long as it lives, so an instance is only ever handed back to a status component owned by the actor it was created for.
+ * An actor's bucket is dropped when that actor ends play so that dead actors' effects (and through their outer, the actors themselves) are not kept alive.
+ */
+UCLASS(Config = Game)
+class NAUSEA_API UStatusEffectPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+//~ Begin USubsystem Interface
+public:
+	virtual void Deinitialize() override;
+//~ End USubsystem Interface
+
+public:
+	static UStatusEffectPoolSubsystem* Get(const UObject* WorldContextObject);
+
+	//Returns a pooled instance of the given class usable by the given status component, or creates a new one. The returned effect still needs to be initialized.
+	UStatusEffectBase* AcquireStatusEffect(TSubclassOf<UStatusEffectBase> StatusEffectClass, UStatusComponent* StatusComponent);
+
+	//Resets the given effect and returns it to its actor's pool. Effects are left for garbage collection if their actor is ending play or its pool for the class is full.
+	void ReleaseStatusEffect(UStatusEffectBase* StatusEffect);
+
+	//Drops every effect pooled for the given actor. Called by status components when their owner ends play.
+	void ReleaseActorPool(const AActor* Actor);
+
+protected:
+	bool CanReuseStatusEffect(const UStatusEffectBase* StatusEffect, const UStatusComponent* StatusComponent) const;
+
+protected:
+	UPROPERTY(Transient)
+	TMap<TWeakObjectPtr<AActor>, FStatusEffectActorPool> ActorPoolMap;
+
+	//Per actor and class.
+	UPROPERTY(Config)
+	int32 MaxPooledStatusEffectsPerClass = 8;
+};
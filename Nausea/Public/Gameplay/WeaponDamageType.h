@@ -19,6 +19,7 @@ class NAUSEA_API UWeaponDamageType : public UCoreDamageType
 
 
 public:
+	//Called when the owning weapon class is loaded. Also requests this damage type's status effect classes (see UCoreDamageType::RequestStatusEffectClassLoad).
 	UFUNCTION()
 	virtual void RegisterOwningFireModeClass(const UFireMode* FireMode);
 
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/GameState.h"
+#include "Gameplay/DamageJournal.h"
 #include "CoreGameState.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FMatchStateChanged, ACoreGameState*, GameState, FName, MatchState);
@@ -48,6 +49,12 @@ public:
 	UFUNCTION()
 	virtual void HandleStatusApplied(AActor* Actor, float& EffectPower, FDamageEvent const& DamageEvent, class AController* EventInstigator, AActor* DamageCauser);
 
+	const FDamageJournal& GetDamageJournal() const { return DamageJournal; }
+	void SetDamageJournalEnabled(bool bEnabled);
+	//Writes the damage journal to the project's saved directory. Returns false if the journal is empty or could not be written.
+	UFUNCTION(BlueprintCallable, Category = GameState)
+	bool DumpDamageJournal(const FString& Filename) const;
+
 	UFUNCTION(BlueprintCallable, Category = GameState)
 	bool AreThereAnyAlivePlayers() const;
 
@@ -74,6 +81,8 @@ protected:
 	UFUNCTION()
 	virtual void ApplyFriendlyFireEffectPowerMultiplier(AActor* Actor, float& EffectPower, FDamageEvent const& DamageEvent, class AController* EventInstigator, AActor* DamageCauser);
 
+	void RecordDamageJournalEntry(EDamageJournalEntryType EntryType, AActor* Actor, float RawAmount, float FinalAmount, FDamageEvent const& DamageEvent, class AController* EventInstigator, EStatusType StatusType = EStatusType::Invalid);
+
 	UFUNCTION()
 	void OnRep_PlayerClassList();
 	UFUNCTION()
@@ -89,6 +98,14 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = GameState)
 	float FriendlyFireEffectPowerMultiplier = 0.f;
 
+	//Number of entries preallocated for the damage journal on the authority. The journal can then be toggled at runtime.
+	UPROPERTY(EditDefaultsOnly, Category = DamageJournal)
+	int32 DamageJournalCapacity = 16384;
+	UPROPERTY(EditDefaultsOnly, Category = DamageJournal)
+	bool bEnableDamageJournal = false;
+
+	FDamageJournal DamageJournal;
+
 	UPROPERTY(Transient, ReplicatedUsing = OnRep_PlayerClassList)
 	TArray<TSubclassOf<UPlayerClassComponent>> PlayerClassList;
 };
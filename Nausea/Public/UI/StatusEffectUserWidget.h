@@ -28,6 +28,9 @@ public:
 	UStatusEffectBase* GetOwningStatusEffect() const { return nullptr; }
 
 protected:
+	//Only called for the effect this widget represents, when it is refreshed.
+	UFUNCTION()
+	virtual void ReceiveStatusEffectRefresh(UStatusEffectBase* Status) {}
 	UFUNCTION()
 	virtual void ReceiveStatusEffectEnd(UStatusEffectBase* Status, EStatusEndType EndType) {}
 	
@@ -49,9 +52,12 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Status Effect User Widget")
 	UStatusEffectBase* GetStatusEffect() const { return StatusEffect; }
 
+	virtual void ReceiveStatusEffectRefresh(UStatusEffectBase* Status) override { OnStatusEffectRefresh(Status); }
 	virtual void ReceiveStatusEffectEnd(UStatusEffectBase* Status, EStatusEndType EndType) override { OnStatusEffectEnd(Status, EndType); }
 
 protected:
+	UFUNCTION(BlueprintImplementableEvent, Category = "Status Effect User Widget")
+	void OnStatusEffectRefresh(UStatusEffectBase* Status);
 	UFUNCTION(BlueprintImplementableEvent, Category = "Status Effect User Widget")
 	void OnStatusEffectEnd(UStatusEffectBase* Status, EStatusEndType EndType);
 };
@@ -65,9 +71,12 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Status Effect User Widget")
 	UStatusEffectBasic* GetStatusEffect() const;
 
+	virtual void ReceiveStatusEffectRefresh(UStatusEffectBase* Status) override;
 	virtual void ReceiveStatusEffectEnd(UStatusEffectBase* Status, EStatusEndType EndType) override;
 
 protected:
+	UFUNCTION(BlueprintImplementableEvent, Category = "Status Effect User Widget")
+	void OnStatusEffectRefresh(UStatusEffectBasic* Status);
 	UFUNCTION(BlueprintImplementableEvent, Category = "Status Effect User Widget")
 	void OnStatusEffectEnd(UStatusEffectBasic* Status, EStatusEndType EndType);
 };
\ No newline at end of file
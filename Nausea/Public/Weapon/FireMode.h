@@ -4,7 +4,6 @@
 
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
-#include "Tickable.h"
 #include "Player/PlayerOwnershipInterface.h"
 #include "WeaponTypes.h"
 #include "FireMode.generated.h"
@@ -19,10 +18,13 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FFireEndSignature, UFireMode*, FireM
  * 
  */
 UCLASS(BlueprintType, Blueprintable, EditInlineNew, DefaultToInstanced, AutoExpandCategories = (Default))
-class NAUSEA_API UFireMode : public UObject, public FTickableGameObject, public IPlayerOwnershipInterface
+class NAUSEA_API UFireMode : public UObject, public IPlayerOwnershipInterface
 {
 	GENERATED_UCLASS_BODY()
 
+	//Fire modes are ticked by their owning weapon, and only while their tick is enabled.
+	friend class UWeapon;
+
 //~ Begin UObject Interface
 public:
 	virtual void PostInitProperties() override;
@@ -30,16 +32,6 @@ public:
 	virtual UWorld* GetWorld() const override final { return (WorldPrivate ? WorldPrivate : GetWorld_Uncached()); } //UActorComponent's implementation
 //~ End UObject Interface
 
-//~ Begin FTickableGameObject Interface
-protected:
-	virtual void Tick(float DeltaTime) override { K2_Tick(DeltaTime); }
-public:
-	virtual ETickableTickType GetTickableTickType() const { return TickType; }
-	virtual bool IsTickable() const { return bTickEnabled && !IsPendingKill(); }
-	virtual TStatId GetStatId() const { return TStatId(); }
-	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
-//~ End FTickableGameObject Interface
-
 //~ Begin IPlayerOwnershipInterface Interface.
 public:
 	virtual ACorePlayerState* GetOwningPlayerState() const override;
@@ -107,6 +99,9 @@ public:
 	UFUNCTION()
 	void ClearHoldingFire() { bHoldingFire = false; }
 
+	UFUNCTION(BlueprintCallable, Category = FireMode)
+	bool IsTickEnabled() const { return bTickEnabled; }
+
 	UFUNCTION(BlueprintCallable, Category = FireMode)
 	TAssetSubclassOf<UUserWidget> GetCrosshairWidget() const { return CrosshairWidget; }
 
@@ -143,9 +138,18 @@ protected:
 	void K2_OnFireComplete();
 	UFUNCTION(BlueprintImplementableEvent, Category = FireMode, meta = (DisplayName="Tick",ScriptName="Tick"))
 	void K2_Tick(float DeltaTime);
+
+	//Called by the owning weapon while this fire mode's tick is enabled.
+	virtual void Tick(float DeltaTime) { K2_Tick(DeltaTime); }
 	
+	//Registers or unregisters this fire mode with its owning weapon's tick. Does nothing if bCanEverTick is false or if bNeverTickOnDedicatedServer is set on a dedicated server.
 	UFUNCTION(BlueprintCallable, Category = FireMode)
-	void SetTickEnabled(bool bInTickEnabled) { bTickEnabled = bInTickEnabled; }
+	void SetTickEnabled(bool bInTickEnabled);
+
+	//Returns true if the owning weapon should call Tick on this fire mode. Subclasses can return true for internal work while bTickEnabled is false.
+	virtual bool ShouldWeaponTick() const { return bTickEnabled; }
+	//Calls UWeapon::SetFireModeTickEnabled with ShouldWeaponTick. Used by SetTickEnabled and by subclasses when their internal tick needs change, regardless of bCanEverTick.
+	void UpdateWeaponTickRegistration();
 
 protected:
 	UPROPERTY(EditDefaultsOnly, Category = FireMode)
@@ -156,8 +160,6 @@ protected:
 	bool bStartWithTickEnabled = false;
 	UPROPERTY(Transient)
 	bool bTickEnabled = false;
-
-	ETickableTickType TickType = ETickableTickType::Never;
 	
 	//Should this fire mode stop other weapon actions when firing?
 	UPROPERTY(EditDefaultsOnly, Category = FireMode)
@@ -7,6 +7,7 @@
 #include "Ammo.generated.h"
 
 class UFireMode;
+class UAmmo;
 class ACoreCharacter;
 class UAmmoUserWidget;
 
@@ -17,12 +18,17 @@ struct FReloadHistory
 
 	FReloadHistory() {}
 
-	FReloadHistory(float InReloadTimeStamp, float InReloadAmount)
+	FReloadHistory(uint16 InSequence, float InReloadTimeStamp, float InReloadAmount)
 	{
+		Sequence = InSequence;
 		ReloadTimeStamp = InReloadTimeStamp;
 		ReloadAmount = InReloadAmount;
 	}
 
+	//Client assigned sequence number of this reload, also sent with Server_Reliable_Reload.
+	UPROPERTY()
+	uint16 Sequence = 0;
+
 	UPROPERTY()
 	float ReloadTimeStamp = -1.f;
 
@@ -36,6 +42,74 @@ struct FReloadHistory
 	bool bHasFailed = false;
 };
 
+//Fixed capacity ring of the reloads a client predicted that the server has yet to acknowledge. Entries are addressed by sequence number so lookup and trimming are O(1).
+struct FReloadHistoryBuffer
+{
+public:
+	static const int32 Capacity = 8;
+
+	//Returns the new entry. If the buffer is full the oldest unacknowledged entry is dropped.
+	FReloadHistory& Add(float ReloadTimeStamp, float ReloadAmount)
+	{
+		if (Num() >= Capacity)
+		{
+			OldestSequence++;
+		}
+
+		const uint16 Sequence = NextSequence++;
+		FReloadHistory& Entry = EntryBuffer[Sequence % Capacity];
+		Entry = FReloadHistory(Sequence, ReloadTimeStamp, ReloadAmount);
+		return Entry;
+	}
+
+	FReloadHistory* Find(uint16 Sequence)
+	{
+		return Contains(Sequence) ? &EntryBuffer[Sequence % Capacity] : nullptr;
+	}
+
+	bool Contains(uint16 Sequence) const { return uint16(Sequence - OldestSequence) < uint16(Num()); }
+
+	//Drops every entry up to and including Sequence.
+	void Acknowledge(uint16 Sequence)
+	{
+		if (Contains(Sequence))
+		{
+			OldestSequence = Sequence + 1;
+		}
+	}
+
+	int32 Num() const { return uint16(NextSequence - OldestSequence); }
+	bool IsEmpty() const { return NextSequence == OldestSequence; }
+	uint16 GetNextSequence() const { return NextSequence; }
+
+	void Reset() { OldestSequence = NextSequence; }
+
+protected:
+	FReloadHistory EntryBuffer[Capacity];
+	//Sequences start at 1 so that the acknowledgement of the first reload differs from UAmmo::AcknowledgedReloadSequence's default and replicates.
+	uint16 OldestSequence = 1;
+	uint16 NextSequence = 1;
+};
+
+//Ammo delta the server corrects an owning client's prediction by. Sent in batches by UInventoryManagerComponent.
+USTRUCT()
+struct FAmmoCorrection
+{
+	GENERATED_USTRUCT_BODY()
+
+	FAmmoCorrection() {}
+
+	FAmmoCorrection(UAmmo* InAmmo, int32 InQuantizedDelta)
+		: Ammo(InAmmo), QuantizedDelta(InQuantizedDelta) {}
+
+public:
+	UPROPERTY()
+	UAmmo* Ammo = nullptr;
+	//Delta in quantized ammo units (see UAmmo::QuantizeAmmo).
+	UPROPERTY()
+	int32 QuantizedDelta = 0;
+};
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FAmmoChangedSignature, UAmmo*, Ammo, float, Amount);
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FReloadBeginSignature, UAmmo*, Ammo);
@@ -95,10 +169,21 @@ public:
 	UFUNCTION(BlueprintCallable, Category = Ammo)
 	virtual bool CanConsumeAmmo(float Amount = 1.f) const;
 
+	//Called on the owning client when the server's batched ammo corrections are received.
 	virtual void ApplyAmmoCorrection(float Amount = 1.f);
 
-	UFUNCTION(Client, Reliable)
-	void Client_Reliable_SendAmmoDeltaCorrection(float Amount = 1.f);
+	//Server. Queues a correction on the owning character's UInventoryManagerComponent, which sends every correction made during a frame in a single RPC.
+	void SendAmmoCorrection(float Amount = 1.f);
+
+	//Ammo amounts replicate as fixed point integers with this many units per ammo. Amounts above MaxReplicatedAmmoAmount cannot be represented.
+	static constexpr float AmmoQuantizationScale = 10.f;
+	static constexpr float MaxReplicatedAmmoAmount = float(MAX_uint16) / AmmoQuantizationScale;
+	static uint16 QuantizeAmmo(float Amount)
+	{
+		ensureMsgf(Amount <= MaxReplicatedAmmoAmount, TEXT("Ammo amount %f exceeds the replicable maximum of %f and will be clamped."), Amount, MaxReplicatedAmmoAmount);
+		return uint16(FMath::Clamp(FMath::RoundToInt(Amount * AmmoQuantizationScale), 0, int32(MAX_uint16)));
+	}
+	static float DequantizeAmmo(uint16 QuantizedAmount) { return float(QuantizedAmount) / AmmoQuantizationScale; }
 
 
 	UFUNCTION(BlueprintCallable, Category = Ammo)
@@ -133,10 +218,14 @@ public:
 
 protected:
 	UFUNCTION(Server, Reliable, WithValidation)
-	void Server_Reliable_Reload(float WorldTimeOverride = -1.f);
+	void Server_Reliable_Reload(uint16 ReloadSequence, float WorldTimeOverride = -1.f);
 	
 	UFUNCTION(Client, Reliable)
-	void Client_Reliable_ReloadFailed(float WorldTimeOverride);
+	void Client_Reliable_ReloadFailed(uint16 ReloadSequence, float WorldTimeOverride);
+
+	//Trims ReloadHistory up to the reload the server last processed.
+	UFUNCTION()
+	void OnRep_AcknowledgedReloadSequence();
 	
 	UFUNCTION()
 	virtual void OnReloadCosmetic() {}
@@ -144,14 +233,21 @@ protected:
 	UFUNCTION()
 	virtual void ReloadComplete(float ReloadStartTime) {}
 
+	//Server. Sets the local value and its quantized replicated counterpart.
+	void SetAmmoAmount(float Amount);
+	void SetMaxAmmoAmount(float Amount);
+
 	UFUNCTION()
-	void OnRep_AmmoAmount(float PreviousAmount);
+	void OnRep_AmmoAmount(uint16 PreviousAmount);
+
+	UFUNCTION()
+	void OnRep_MaxAmmoAmount();
 
 	UFUNCTION()
 	void OnRep_InitialAmount();
 
 protected:
-	UPROPERTY(Replicated, EditDefaultsOnly, Category = Ammo)
+	UPROPERTY(EditDefaultsOnly, Category = Ammo)
 	float MaxAmmoAmount = 100.f;
 
 	UPROPERTY(EditDefaultsOnly, Category = Ammo)
@@ -167,14 +263,25 @@ protected:
 	UPROPERTY(Transient)
 	bool bDoneFirstInitialization = false;
 	
-	UPROPERTY(Transient, ReplicatedUsing = OnRep_AmmoAmount)
+	UPROPERTY(Transient)
 	float AmmoAmount = -1.f;
 
-	UPROPERTY(Transient, ReplicatedUsing = OnRep_InitialAmount)
+	UPROPERTY(Transient)
 	float InitialAmmo = -1.f;
 
-	UPROPERTY()
-	TArray<FReloadHistory> ReloadHistory;
+	//Quantized replicated ammo state. Replicated to every connection (not only the owner) so that spectators and replays can display it.
+	UPROPERTY(Transient, ReplicatedUsing = OnRep_AmmoAmount)
+	uint16 ReplicatedAmmoAmount = 0;
+	UPROPERTY(Transient, ReplicatedUsing = OnRep_MaxAmmoAmount)
+	uint16 ReplicatedMaxAmmoAmount = 0;
+	UPROPERTY(Transient, ReplicatedUsing = OnRep_InitialAmount)
+	uint16 ReplicatedInitialAmmo = 0;
+
+	FReloadHistoryBuffer ReloadHistory;
+
+	//Sequence of the last reload request processed by the server. Replicated with COND_OwnerOnly.
+	UPROPERTY(Transient, ReplicatedUsing = OnRep_AcknowledgedReloadSequence)
+	uint16 AcknowledgedReloadSequence = 0;
 
 private:
 	UWorld* WorldPrivate = nullptr;
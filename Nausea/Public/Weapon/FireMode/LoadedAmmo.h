@@ -30,7 +30,7 @@ public:
 protected:
 	virtual void OnReloadCosmetic() override;
 	virtual void UpdateAmmoCapacity(bool bFirstInitialization) override;
-	virtual void Client_Reliable_ReloadFailed_Implementation(float WorldTimeOverride) override;
+	virtual void Client_Reliable_ReloadFailed_Implementation(uint16 ReloadSequence, float WorldTimeOverride) override;
 //~ End UAmmo Interface
 
 public:
@@ -65,8 +65,11 @@ public:
 	FAmmoChangedSignature OnLoadedAmmoChanged;
 
 protected:
+	//Server. Sets the local value and its quantized replicated counterpart.
+	void SetLoadedAmmoAmount(float Amount);
+
 	UFUNCTION()
-	void OnRep_LoadedAmmoAmount(float PreviousAmount);
+	void OnRep_LoadedAmmoAmount(uint16 PreviousAmount);
 
 	UFUNCTION()
 	void OnRep_ReloadCounter();
@@ -77,9 +80,13 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = Ammo)
 	float MaxLoadedAmmoAmount = 10.f;
 
-	UPROPERTY(Transient, ReplicatedUsing = OnRep_LoadedAmmoAmount)
+	UPROPERTY(Transient)
 	float LoadedAmmoAmount = -1.f;
 
+	//Replicated to every connection so that spectators and replays can display it.
+	UPROPERTY(Transient, ReplicatedUsing = OnRep_LoadedAmmoAmount)
+	uint16 ReplicatedLoadedAmmoAmount = 0;
+
 	UPROPERTY(EditDefaultsOnly, Category = Ammo)
 	float ReloadRate = 1.f;
 
@@ -95,6 +102,7 @@ protected:
 	UPROPERTY()
 	FTimerHandle ReloadTimer;
 	
+	//Drives reload cosmetics on simulated proxies. Wraps around.
 	UPROPERTY(Transient, ReplicatedUsing = OnRep_ReloadCounter)
-	int32 ReloadCounter = 0;
+	uint8 ReloadCounter = 0;
 };
\ No newline at end of file
@@ -6,6 +6,65 @@
 #include "Weapon/FireMode.h"
 #include "ReplicatedFireMode.generated.h"
 
+UENUM()
+enum class EFireRequestType : uint8
+{
+	Fire,
+	StopFire
+};
+
+//A run of consecutive shots (or a stop fire) made by the owning client. Shots are numbered Sequence to Sequence + ShotCount - 1.
+USTRUCT()
+struct FFireRequest
+{
+	GENERATED_USTRUCT_BODY()
+
+	FFireRequest() {}
+
+public:
+	UPROPERTY()
+	uint16 Sequence = 0;
+	UPROPERTY()
+	EFireRequestType RequestType = EFireRequestType::Fire;
+	//Zero for stop fire requests.
+	UPROPERTY()
+	uint8 ShotCount = 0;
+	//Server world time of the first shot as estimated by the client (AGameStateBase::GetServerWorldTimeSeconds). Following shots are spaced by the fire mode's refire time.
+	//Used by the server to rewind hit characters when replaying the shots.
+	UPROPERTY()
+	float StartTime = -1.f;
+};
+
+//Every fire request the server has yet to acknowledge. Requests are resent in every batch until acknowledged so that a lost packet is covered by the next one.
+USTRUCT()
+struct FFireRequestBatch
+{
+	GENERATED_USTRUCT_BODY()
+
+	FFireRequestBatch() {}
+
+public:
+	UPROPERTY()
+	TArray<FFireRequest> RequestList;
+};
+
+//Owner only server state used by the client to trim its pending requests and to correct rejected shots.
+USTRUCT()
+struct FFireAcknowledgement
+{
+	GENERATED_USTRUCT_BODY()
+
+	FFireAcknowledgement() {}
+
+public:
+	//Sequence of the last request the server processed (its last shot for fire requests).
+	UPROPERTY()
+	uint16 LastProcessedSequence = 0;
+	//Cumulative number of shots the server rejected. The client corrects by the difference with the last value it saw.
+	UPROPERTY()
+	uint16 TotalRejectedShots = 0;
+};
+
 /**
  * 
  */
@@ -27,17 +86,49 @@ public:
 public:
 	virtual bool Fire(float WorldTimeOverride = -1.f) override;
 	virtual void StopFire(float WorldTimeOverride = -1.f) override;
+protected:
+	//Flushes pending fire requests. Only forwards to UFireMode::Tick while bTickEnabled is set.
+	virtual void Tick(float DeltaTime) override;
+	virtual bool ShouldWeaponTick() const override { return Super::ShouldWeaponTick() || bFireRequestFlushPending; }
 //~ End UFireMode Interface 
 
+public:
+	//Returns true if sequence A comes after sequence B, accounting for wrap around.
+	static bool IsSequenceNewer(uint16 A, uint16 B) { return int16(A - B) > 0; }
+
+	//Seed of the shot with the given sequence number. Every machine derives the same seed, so spread and recoil rolled from it are reproduced exactly by the server and by replays.
+	uint32 GetShotSeed(uint16 ShotSequence) const { return HashCombine(ShotSeedSalt, uint32(ShotSequence)); }
+	FRandomStream GetShotRandomStream(uint16 ShotSequence) const { return FRandomStream(int32(GetShotSeed(ShotSequence))); }
+
+	//Sequence number of the shot currently being performed (locally or while the server replays a request).
+	uint16 GetCurrentShotSequence() const { return CurrentShotSequence; }
+
 protected:
-	UFUNCTION(Server, Reliable, WithValidation)
-	void Server_Reliable_Fire(float WorldTimeOverride = -1.f);
-	UFUNCTION(Server, Reliable, WithValidation)
-	void Server_Reliable_StopFire(float WorldTimeOverride = -1.f);
-
-	UFUNCTION(Client, Reliable)
-	void Client_Reliable_FailedFire();
-	
+	//Owning client. Records a shot (merged into the newest request if it continues it) or a stop fire. Pending requests are sent once per frame.
+	void QueueFireRequest(EFireRequestType RequestType, float WorldTime);
+	//Owning client. Sends every unacknowledged request. Sets bFireRequestFlushPending while any are pending so that the weapon keeps ticking this fire mode and they are resent until acknowledged.
+	void FlushFireRequests();
+
+	UFUNCTION(Server, Unreliable, WithValidation)
+	void Server_Unreliable_FireRequests(const FFireRequestBatch& RequestBatch);
+
+	//Server. Rebuilds and performs the shots of a request that has not been processed yet, after ValidateFireRequest. Returns the number of shots that were rejected.
+	virtual int32 ProcessFireRequest(const FFireRequest& Request);
+
+	//Server. Clamps the client supplied StartTime to the current server time and the lag compensation rewind window (see ULagCompensationSubsystem::GetMaxRewindTime),
+	//and no earlier than one shot interval after LastAcceptedShotTime. Then caps ShotCount to the shots that fit at the fire rate between StartTime and the current server time.
+	//Returns the number of shots removed from the request.
+	virtual int32 ValidateFireRequest(FFireRequest& Request) const;
+
+	//Minimum time between two shots. Zero if the fire mode is not rate limited, in which case ShotCount is not capped.
+	virtual float GetShotInterval() const { return 0.f; }
+
+	//Owning client. Called with the number of shots rejected by the server since the last acknowledgement.
+	virtual void OnFireRejected(int32 NumRejectedShots) {}
+
+	UFUNCTION()
+	virtual void OnRep_FireAcknowledgement();
+
 	UFUNCTION()
 	virtual void OnRep_FireCounter();
 
@@ -47,6 +138,44 @@ protected:
 protected:
 	UPROPERTY(ReplicatedUsing = OnRep_FireCounter)
 	int32 FireCounter = 0;
+	//Sequence of the last shot counted by FireCounter. Received in the same update as FireCounter so that simulated proxies can derive the seeds of the shots they replay in OnRep_FireCounter.
+	UPROPERTY(Transient, Replicated)
+	uint16 FireCounterShotSequence = 0;
 
 	int32 LocalFireCounter = 0;
+
+	UPROPERTY(Transient, ReplicatedUsing = OnRep_FireAcknowledgement)
+	FFireAcknowledgement FireAcknowledgement;
+
+	//Server chosen salt combined with shot sequence numbers to make shot seeds. Chosen by the server so that a client cannot pick favourable seeds.
+	//Replicated to everyone (not only the owner) so that simulated proxies roll the same spread for their cosmetic shots.
+	UPROPERTY(Transient, Replicated)
+	uint32 ShotSeedSalt = 0;
+
+	//Ring buffer of requests sent but not yet acknowledged, oldest first starting at PendingFireRequestHead.
+	static const int32 MaxPendingFireRequests = 16;
+	FFireRequest PendingFireRequests[MaxPendingFireRequests];
+	int32 PendingFireRequestHead = 0;
+	int32 NumPendingFireRequests = 0;
+	bool bHasUnsentFireRequests = false;
+	//Keeps this fire mode registered with its weapon's tick independently of bCanEverTick and bTickEnabled. See ShouldWeaponTick.
+	bool bFireRequestFlushPending = false;
+
+	//Sequence number given to the next shot or stop fire.
+	uint16 NextFireSequence = 1;
+
+	uint16 CurrentShotSequence = 0;
+
+	//Last FFireAcknowledgement::TotalRejectedShots seen by the owning client.
+	uint16 LastSeenRejectedShots = 0;
+
+	//Server. Server world time of the last shot accepted from the owning client.
+	float LastAcceptedShotTime = -1.f;
+
+	//Fraction of the shot interval a shot may arrive early and still be accepted, to absorb client frame time jitter.
+	UPROPERTY(EditDefaultsOnly, Category = FireMode)
+	float ShotIntervalTolerance = 0.1f;
+
+	UPROPERTY(Transient)
+	FFireRequestBatch OutgoingFireRequestBatch;
 };
@@ -3,7 +3,9 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
 #include "Weapon/FireMode/ReplicatedFireMode.h"
+#include "Weapon/ProjectileManagerSubsystem.h"
 #include "WeaponFireMode.generated.h"
 
 class UWeaponDamageType;
@@ -16,6 +18,85 @@ enum class EFireType : uint8
 	MAX = 255
 };
 
+UENUM(BlueprintType)
+enum class EShotType : uint8
+{
+	Hitscan, //Rounds are resolved immediately through FireHitscan.
+	Projectile, //Rounds are handed to the UProjectileManagerSubsystem.
+	MAX = 255
+};
+
+USTRUCT()
+struct FHitscanTrace
+{
+	GENERATED_USTRUCT_BODY()
+
+	FHitscanTrace() {}
+
+	FHitscanTrace(const FVector& InStart, const FVector& InEnd, float InFireTime = -1.f)
+		: Start(InStart), End(InEnd), FireTime(InFireTime) {}
+
+public:
+	UPROPERTY()
+	FVector Start = FVector::ZeroVector;
+	UPROPERTY()
+	FVector End = FVector::ZeroVector;
+	//Server world time this trace's round was fired at. Characters are rewound to it through the ULagCompensationSubsystem. Negative for traces resolved against the present.
+	UPROPERTY()
+	float FireTime = -1.f;
+};
+
+//Every hit a single body part of a victim received from a hitscan batch, aggregated into one damage application.
+USTRUCT()
+struct FHitscanVictimHit
+{
+	GENERATED_USTRUCT_BODY()
+
+	FHitscanVictimHit() {}
+
+public:
+	UPROPERTY()
+	AActor* Victim = nullptr;
+	//Body part hit, from UStatusComponent::GetPartHealthIndexForBone. INDEX_NONE for victims without a status component or hits outside of any part.
+	UPROPERTY()
+	int32 PartIndex = INDEX_NONE;
+	//First hit received by this body part. Used as the damage event's hit info, so its bone drives the part's damage multiplier and part health.
+	UPROPERTY()
+	FHitResult Hit;
+	UPROPERTY()
+	FVector ShotDirection = FVector::ZeroVector;
+	UPROPERTY()
+	float Damage = 0.f;
+	UPROPERTY()
+	int32 NumHits = 0;
+};
+
+//All traces of one fire (every pellet of every round fired this frame). Kept on the fire mode and reset between uses so that firing does not allocate.
+USTRUCT()
+struct FHitscanBatch
+{
+	GENERATED_USTRUCT_BODY()
+
+	FHitscanBatch() {}
+
+public:
+	void Reset()
+	{
+		TraceList.Reset();
+		HitList.Reset();
+		VictimHitList.Reset();
+	}
+
+public:
+	UPROPERTY()
+	TArray<FHitscanTrace> TraceList;
+	//Parallel to TraceList. Missed traces have bBlockingHit set to false.
+	UPROPERTY()
+	TArray<FHitResult> HitList;
+	UPROPERTY()
+	TArray<FHitscanVictimHit> VictimHitList;
+};
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FFireModeSpreadUpdateSignature, UWeaponFireMode*, FireMode, float, Spread);
 
 /**
@@ -26,12 +107,8 @@ class NAUSEA_API UWeaponFireMode : public UReplicatedFireMode
 {
 	GENERATED_UCLASS_BODY()
 
-//~ Begin FTickableGameObject Interface
-protected:
-	virtual void Tick(float DeltaTime) override;
-public:
-	virtual bool IsTickable() const { return !IsPendingKill() && (bTickEnabled || CurrentSpread > 0.f); }
-//~ End FTickableGameObject Interface
+	//Projectile manager reports impacts of this fire mode's projectiles.
+	friend class UProjectileManagerSubsystem;
 
 //~ Begin UFireMode Interface
 public:
@@ -51,14 +128,24 @@ protected:
 	virtual void FireComplete() override;
 	virtual void BindWeaponEvents() override;
 	virtual void UnBindWeaponEvents() override;
-	virtual void Client_Reliable_FailedFire_Implementation() override;
+	//Broadcasts OnFireModeSpreadUpdate with the decayed spread while bSpreadRecovering is set.
+	virtual void Tick(float DeltaTime) override;
+	virtual bool ShouldWeaponTick() const override { return Super::ShouldWeaponTick() || bSpreadRecovering; }
 //~ End UFireMode Interface
 
+//~ Begin UReplicatedFireMode Interface
+protected:
+	virtual int32 ProcessFireRequest(const FFireRequest& Request) override;
+	virtual float GetShotInterval() const override;
+	virtual void OnFireRejected(int32 NumRejectedShots) override;
+//~ End UReplicatedFireMode Interface
+
 public:
 	UFUNCTION(BlueprintCallable, Category = FireMode)
 	float GetFireRate() const;
 
-	UFUNCTION(BlueprintCallable, Category = FireMode)
+	//Spread decays in closed form from the last shot so no tick is needed to keep it up to date.
+	UFUNCTION(BlueprintPure, Category = FireMode)
 	float GetFireSpread() const;
 
 	UFUNCTION(BlueprintCallable, Category = FireMode)
@@ -83,12 +170,35 @@ protected:
 	UFUNCTION()
 	virtual bool ConsumeAmmo();
 
+	//Builds, traces and applies the damage of NumShots rounds (each made of TracesPerShot traces) as a single batch. Rounds are numbered from FirstShotSequence.
+	//FirstShotTime is the server world time of the first round when the server replays a client's request (FFireRequest::StartTime), negative otherwise.
+	virtual void FireHitscan(uint16 FirstShotSequence, int32 NumShots = 1, float FirstShotTime = -1.f);
+	//Adds every trace of the given rounds to the batch. Spread of each round is rolled from GetShotRandomStream of its sequence number.
+	//If FirstShotTime is set, each round's traces get FirstShotTime plus the round's offset at the fire rate as their FireTime.
+	virtual void BuildHitscanTraces(uint16 FirstShotSequence, int32 NumShots, float FirstShotTime, FHitscanBatch& Batch) const;
+	//Runs every trace of the batch back to back using a single set of query parameters.
+	//Traces with a FireTime ignore registered characters' present collision and are tested against their hitboxes rewound to that time instead (see ULagCompensationSubsystem::RewindTraceCharacters), keeping the closest hit.
+	virtual void PerformHitscanTraces(FHitscanBatch& Batch) const;
+	//Groups the batch's hits per victim and body part and applies one point damage event per group, using the group's first hit and the sum of all of its hits' damage.
+	//Hits on different parts of a victim are never merged so that each keeps its own bone, damage multiplier and part health.
+	virtual void ApplyHitscanBatchDamage(FHitscanBatch& Batch);
+
+	//Spawns NumShots rounds (each made of TracesPerShot projectiles) in the UProjectileManagerSubsystem. Authoritative on the server, cosmetic elsewhere.
+	virtual void FireProjectile(uint16 FirstShotSequence, int32 NumShots = 1);
+	//Called by the UProjectileManagerSubsystem when one of this fire mode's authoritative projectiles impacts (after bounces) or expires. Hit is invalid on expiry.
+	virtual void OnProjectileImpact(const FHitResult& Hit, const FVector& Location, const FVector& Velocity);
+
+	//Recoil pitch and yaw variance are rolled from the shot's seed.
 	UFUNCTION()
-	virtual void ApplyRecoil();
+	virtual void ApplyRecoil(uint16 ShotSequence);
+
+	//Returns Direction randomly deviated within a cone of the given spread (in degrees) using the given shot stream.
+	static FVector ApplySpreadToDirection(const FVector& Direction, float Spread, FRandomStream& ShotStream) { return Spread > 0.f ? ShotStream.VRandCone(Direction, FMath::DegreesToRadians(Spread * 0.5f)) : Direction; }
 
 	virtual void UpdateFireCounter() override;
 
 public:
+	//Broadcast when a shot changes spread and every frame while spread recovers afterward, as long as something is bound to it.
 	UPROPERTY(BlueprintAssignable, Category = FireMode)
 	FFireModeSpreadUpdateSignature OnFireModeSpreadUpdate;
 
@@ -99,6 +209,9 @@ protected:
 	UPROPERTY(EditDefaultsOnly)
 	EFireType FireType = EFireType::SemiAuto;
 
+	UPROPERTY(EditDefaultsOnly)
+	EShotType ShotType = EShotType::Hitscan;
+
 	UPROPERTY(EditDefaultsOnly, Instanced, Replicated)
 	class UAmmo* Ammo = nullptr;
 
@@ -120,13 +233,33 @@ protected:
 	float SpreadPercentIncreasePerShot = 0.1f;
 	UPROPERTY(EditDefaultsOnly, Category = Spread)
 	float SpreadDecayRate = 0.5f;
+	//Spread right after the last shot and the world time of that shot. GetFireSpread decays from these.
+	UPROPERTY(Transient)
+	float SpreadAtLastShot = 0.f;
 	UPROPERTY(Transient)
-	float CurrentSpread = 0.f;
+	float LastShotTime = -1.f;
 	UPROPERTY(Transient)
 	float CurrentSpreadDecayRate = 0.f;
+	//Set by a shot when OnFireModeSpreadUpdate is bound. Keeps this fire mode on its weapon's tick until spread is back to its minimum.
+	UPROPERTY(Transient)
+	bool bSpreadRecovering = false;
 
 	UPROPERTY(EditDefaultsOnly, Category = Damage)
 	TSubclassOf<UWeaponDamageType> WeaponDamageType = nullptr;
 	UPROPERTY(EditDefaultsOnly, Category = Damage)
 	float WeaponDamage = 0.f;
+
+	//Number of traces (pellets) fired per round. Only used by hitscan fire modes.
+	UPROPERTY(EditDefaultsOnly, Category = Hitscan)
+	int32 TracesPerShot = 1;
+	UPROPERTY(EditDefaultsOnly, Category = Hitscan)
+	float HitscanRange = 10000.f;
+	UPROPERTY(EditDefaultsOnly, Category = Hitscan)
+	TEnumAsByte<ECollisionChannel> HitscanTraceChannel = ECC_Visibility;
+
+	UPROPERTY(Transient)
+	FHitscanBatch HitscanBatch;
+
+	UPROPERTY(EditDefaultsOnly, Category = Projectile, meta = (EditCondition = "ShotType == EShotType::Projectile"))
+	FProjectileDescription ProjectileDescription;
 };
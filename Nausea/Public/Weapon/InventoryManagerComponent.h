@@ -5,6 +5,8 @@
 #include "CoreMinimal.h"
 #include "Character/CoreCharacterComponent.h"
 #include "WeaponTypes.h"
+#include "Weapon/FireMode/Ammo.h"
+#include "Engine/StreamableManager.h"
 #include "InventoryManagerComponent.generated.h"
 
 class UInputComponent;
@@ -23,6 +25,8 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FInventoryGroupUpdateSignature, EWea
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FCurrentWeaponUpdateSignature, UWeapon*, CurrentWeapon);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FPendingWeaponUpdateSignature, UWeapon*, PendingWeapon);
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FInventoryAssetsReadySignature, UInventoryManagerComponent*, InventoryManager);
+
 USTRUCT(BlueprintType)
 struct NAUSEA_API FWeaponGroupArray
 {
@@ -137,6 +141,21 @@ public:
 	UFUNCTION(BlueprintCallable, Category = InventoryManager)
 	const TMap<EWeaponGroup, FWeaponGroupArray>& GetWeaponGroupMap() const { return WeaponGroupMap; }
 
+	//Streams every asset of the given inventory classes (the classes themselves, which pull in their meshes and animation objects, plus their soft UI references). Replaces any preload in progress.
+	void RequestInventoryAssetPreload(const TArray<TSoftClassPtr<UInventory>>& InventoryClassList);
+
+	UFUNCTION(BlueprintCallable, Category = InventoryManager)
+	bool AreInventoryAssetsReady() const { return bInventoryAssetsReady; }
+	UFUNCTION(BlueprintCallable, Category = InventoryManager)
+	float GetInventoryAssetLoadProgress() const;
+
+	//Returns true if the assets the weapon needs to be equipped are resident. Equipping only waits on weapons for which this is false, regardless of the state of the overall preload.
+	UFUNCTION(BlueprintCallable, Category = InventoryManager)
+	bool AreWeaponAssetsLoaded(const UWeapon* Weapon) const;
+
+	//Server. Accumulates an ammo correction for the owning client. Corrections queued during a frame are merged per ammo object and sent in a single RPC on the next tick.
+	void QueueAmmoCorrection(UAmmo* Ammo, float Amount);
+
 public:
 	UPROPERTY(BlueprintAssignable, Category = Inventory)
 	FInventoryAddedSignature OnInventoryAdded;
@@ -153,6 +172,9 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = Inventory)
 	FPendingWeaponUpdateSignature OnPendingWeaponUpdate;
 
+	UPROPERTY(BlueprintAssignable, Category = Inventory)
+	FInventoryAssetsReadySignature OnInventoryAssetsReady;
+
 protected:
 	template<EFireMode Index>
 	void StartFire()
@@ -204,6 +226,11 @@ protected:
 
 	UFUNCTION(Client, Reliable)
 	void Client_Reliable_CurrentWeaponSet(UWeapon* Weapon);
+
+	UFUNCTION()
+	void FlushAmmoCorrections();
+	UFUNCTION(Client, Reliable)
+	void Client_Reliable_ApplyAmmoCorrections(const TArray<FAmmoCorrection>& CorrectionList);
 	UFUNCTION()
 	void CheckWeaponSynchronization();
 
@@ -214,6 +241,18 @@ protected:
 	UFUNCTION()
 	virtual void UpdateWeaponGroupMap();
 
+	//Preloads the DefaultInventoryList and the owning player's selected FInventorySelectionArray for the given player class. Bound to the player state's player class changed delegate alongside OnPlayerClassChanged.
+	UFUNCTION()
+	void PreloadPlayerClassInventory(ACorePlayerState* PlayerState, UPlayerClassComponent* PlayerClassComponent);
+
+	void GatherInventoryAssets(const TSoftClassPtr<UInventory>& InventoryClass, TArray<FSoftObjectPath>& AssetList) const;
+
+	UFUNCTION()
+	void OnInventoryAssetsLoaded();
+
+	//Equips WeaponAwaitingAssets once its own assets have finished streaming in.
+	void OnWeaponAssetsLoaded();
+
 	UFUNCTION()
 	virtual void OnInventoryEndPlay(UCoreCharacterComponent* Component, EEndPlayReason::Type Reason);
 
@@ -257,4 +296,18 @@ private:
 
 	UPROPERTY(Transient)
 	UWeapon* CurrentServerWeapon = NULL;
+
+	TSharedPtr<FStreamableHandle> InventoryAssetHandle;
+	UPROPERTY(Transient)
+	bool bInventoryAssetsReady = false;
+
+	//Weapon whose equip is blocked on assets that were not resident yet, and the handle loading only those.
+	UPROPERTY(Transient)
+	UWeapon* WeaponAwaitingAssets = nullptr;
+	TSharedPtr<FStreamableHandle> WeaponAssetHandle;
+
+	UPROPERTY(Transient)
+	TArray<FAmmoCorrection> PendingAmmoCorrectionList;
+	UPROPERTY(Transient)
+	bool bAmmoCorrectionFlushQueued = false;
 };
@@ -0,0 +1,165 @@
+// Copyright 2020-2021 Jean-David Veilleux-Foppiano. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "LagCompensationSubsystem.generated.h"
+
+class ACoreCharacter;
+
+//Shape of a single hitbox, captured from the character mesh's physics asset when the character is registered. Hitboxes are tested as capsules.
+USTRUCT()
+struct FLagCompensationHitboxShape
+{
+	GENERATED_USTRUCT_BODY()
+
+	FLagCompensationHitboxShape() {}
+
+public:
+	UPROPERTY()
+	FName BoneName = NAME_None;
+	UPROPERTY()
+	float Radius = 0.f;
+	//Zero for spheres.
+	UPROPERTY()
+	float HalfLength = 0.f;
+};
+
+//Hitbox history of a single character. Transforms are stored sample major (all hitboxes of sample 0, then sample 1, etc.) in a buffer sized once on registration.
+USTRUCT()
+struct FCharacterHitboxHistory
+{
+	GENERATED_USTRUCT_BODY()
+
+	FCharacterHitboxHistory() {}
+
+public:
+	const FTransform& GetHitboxTransform(int32 SampleIndex, int32 HitboxIndex) const { return HitboxTransformBuffer[(SampleIndex * HitboxShapeList.Num()) + HitboxIndex]; }
+	FTransform& GetHitboxTransform(int32 SampleIndex, int32 HitboxIndex) { return HitboxTransformBuffer[(SampleIndex * HitboxShapeList.Num()) + HitboxIndex]; }
+
+public:
+	UPROPERTY()
+	TWeakObjectPtr<ACoreCharacter> Character = nullptr;
+
+	UPROPERTY()
+	TArray<FLagCompensationHitboxShape> HitboxShapeList;
+
+	UPROPERTY()
+	TArray<FTransform> HitboxTransformBuffer;
+
+	//Broad phase. Location of the character's capsule per sample.
+	UPROPERTY()
+	TArray<FVector> CapsuleLocationBuffer;
+
+	//Sample index at which this character was first recorded. Samples taken before that are invalid for this character.
+	UPROPERTY()
+	int32 FirstSampleCount = 0;
+};
+
+//Result of a rewound hit test.
+USTRUCT(BlueprintType)
+struct FLagCompensationHitResult
+{
+	GENERATED_USTRUCT_BODY()
+
+	FLagCompensationHitResult() {}
+
+public:
+	UPROPERTY(BlueprintReadOnly)
+	bool bHit = false;
+	UPROPERTY(BlueprintReadOnly)
+	FName BoneName = NAME_None;
+	UPROPERTY(BlueprintReadOnly)
+	FVector ImpactPoint = FVector::ZeroVector;
+	//Server time the character was rewound to.
+	UPROPERTY(BlueprintReadOnly)
+	float RewoundTime = -1.f;
+	UPROPERTY(BlueprintReadOnly)
+	ACoreCharacter* Character = nullptr;
+};
+
+/**
+ * Server only history of ACoreCharacter hitbox transforms, sampled at most every SampleInterval into fixed size ring buffers.
+ * Buffers are sized by time (MaxRewindTime / SampleInterval) rather than by tick rate, so the covered window holds on listen servers whose frame rate varies.
+ * Fire modes rewind targets to the time a client fired when the server replays its hitscan shots, without any per-shot allocation.
+ */
+UCLASS(Config = Game)
+class NAUSEA_API ULagCompensationSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+//~ Begin USubsystem Interface
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+//~ End USubsystem Interface
+
+//~ Begin FTickableGameObject Interface
+protected:
+	virtual void Tick(float DeltaTime) override { RecordSample(); }
+public:
+	virtual ETickableTickType GetTickableTickType() const { return ETickableTickType::Conditional; }
+	virtual bool IsTickable() const { return CharacterHistoryList.Num() > 0; }
+	virtual TStatId GetStatId() const { return TStatId(); }
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+//~ End FTickableGameObject Interface
+
+public:
+	static ULagCompensationSubsystem* Get(const UObject* WorldContextObject);
+
+	//Called by characters on the authority when they begin play. Does nothing on clients.
+	void RegisterCharacter(ACoreCharacter* Character);
+	void UnregisterCharacter(ACoreCharacter* Character);
+
+	//Oldest server time that can still be rewound to.
+	float GetOldestSampleTime() const;
+	float GetMaxRewindTime() const { return MaxRewindTime; }
+
+	//Tests a segment against the given character's hitboxes as they were at ServerTime (interpolated between the two closest samples). ServerTime is clamped to the recorded history.
+	bool RewindTrace(const ACoreCharacter* Character, float ServerTime, const FVector& TraceStart, const FVector& TraceEnd, FLagCompensationHitResult& OutResult) const;
+
+	//Tests a segment against the rewound hitboxes of every registered character (other than IgnoreCharacter) whose recorded capsule location is near the segment. Returns the closest hit.
+	bool RewindTraceCharacters(float ServerTime, const FVector& TraceStart, const FVector& TraceEnd, const ACoreCharacter* IgnoreCharacter, FLagCompensationHitResult& OutResult) const;
+
+	//Characters whose present collision rewound traces should ignore.
+	void GetRegisteredCharacters(TArray<const AActor*>& OutCharacterList) const;
+
+protected:
+	//Records a sample if at least SampleInterval has passed since the last one.
+	void RecordSample();
+
+	//Finds the two samples surrounding ServerTime and the interpolation alpha between them. Returns false if there is no history.
+	bool GetSampleIndicesForTime(float ServerTime, int32& OutOlderSampleIndex, int32& OutNewerSampleIndex, float& OutAlpha) const;
+
+	int32 GetSampleBufferIndex(int32 SampleCount) const { return SampleCount % NumSamples; }
+
+protected:
+	//Longest ping (round trip, in seconds) we will rewind for. Shots older than this are rewound to the oldest sample.
+	UPROPERTY(Config)
+	float MaxRewindTime = 0.25f;
+
+	//Minimum time, in seconds, between two samples. Frames closer together than this share a sample.
+	UPROPERTY(Config)
+	float SampleInterval = 1.f / 60.f;
+
+	UPROPERTY(Config)
+	int32 MaxHitboxesPerCharacter = 20;
+
+	//Size of every ring buffer. Derived from MaxRewindTime and SampleInterval on initialization.
+	UPROPERTY(Transient)
+	int32 NumSamples = 0;
+
+	//Server time of every sample. Shared by all characters.
+	UPROPERTY(Transient)
+	TArray<float> SampleTimeBuffer;
+
+	//Total number of samples recorded since initialization. The newest sample is at GetSampleBufferIndex(SampleCount - 1).
+	UPROPERTY(Transient)
+	int32 SampleCount = 0;
+
+	UPROPERTY(Transient)
+	TArray<FCharacterHitboxHistory> CharacterHistoryList;
+};
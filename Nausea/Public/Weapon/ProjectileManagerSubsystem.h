@@ -0,0 +1,161 @@
+// Copyright 2020-2021 Jean-David Veilleux-Foppiano. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "Engine/EngineTypes.h"
+#include "ProjectileManagerSubsystem.generated.h"
+
+class AActor;
+class UWeaponFireMode;
+
+//Designer facing description of a projectile fired by a UWeaponFireMode.
+USTRUCT(BlueprintType)
+struct FProjectileDescription
+{
+	GENERATED_USTRUCT_BODY()
+
+	FProjectileDescription() {}
+
+public:
+	UPROPERTY(EditDefaultsOnly, Category = Projectile)
+	float InitialSpeed = 3000.f;
+	UPROPERTY(EditDefaultsOnly, Category = Projectile)
+	float GravityScale = 1.f;
+	//Radius of the sphere swept every step. Zero uses a line trace.
+	UPROPERTY(EditDefaultsOnly, Category = Projectile)
+	float CollisionRadius = 0.f;
+	UPROPERTY(EditDefaultsOnly, Category = Projectile)
+	TEnumAsByte<ECollisionChannel> CollisionChannel = ECC_Visibility;
+
+	//Projectile is removed (and explodes, if it has an explosion) after this long.
+	UPROPERTY(EditDefaultsOnly, Category = Projectile)
+	float Lifetime = 5.f;
+	//Number of impacts the projectile bounces off before its impact is handled. Grenades will want this above zero.
+	UPROPERTY(EditDefaultsOnly, Category = Projectile)
+	int32 MaxBounces = 0;
+	UPROPERTY(EditDefaultsOnly, Category = Projectile, meta = (EditCondition = "MaxBounces > 0"))
+	float Bounciness = 0.3f;
+
+	//Explosion applied through AActor::ApplyRadialDamageBatch on impact or expiry. No explosion if ExplosionOuterRadius is zero.
+	UPROPERTY(EditDefaultsOnly, Category = Explosion)
+	float ExplosionInnerRadius = 0.f;
+	UPROPERTY(EditDefaultsOnly, Category = Explosion)
+	float ExplosionOuterRadius = 0.f;
+	UPROPERTY(EditDefaultsOnly, Category = Explosion)
+	float ExplosionFalloff = 1.f;
+	UPROPERTY(EditDefaultsOnly, Category = Explosion)
+	float ExplosionMinimumDamage = 0.f;
+
+	//Cosmetic actor attached to the projectile on machines that render it. Taken from a pool, must not replicate or have collision.
+	UPROPERTY(EditDefaultsOnly, Category = Visual)
+	TSoftClassPtr<AActor> VisualActorClass;
+};
+
+USTRUCT()
+struct FProjectileHandle
+{
+	GENERATED_USTRUCT_BODY()
+
+	FProjectileHandle() {}
+
+	FProjectileHandle(int32 InProjectileID)
+		: ProjectileID(InProjectileID) {}
+
+	bool IsValid() const { return ProjectileID != INDEX_NONE; }
+
+public:
+	UPROPERTY()
+	int32 ProjectileID = INDEX_NONE;
+};
+
+USTRUCT()
+struct FProjectileVisualActorPool
+{
+	GENERATED_USTRUCT_BODY()
+
+	FProjectileVisualActorPool() {}
+
+public:
+	UPROPERTY()
+	TArray<AActor*> VisualActorList;
+};
+
+/**
+ * Owns every projectile in the world. Projectile state is stored in parallel arrays and every projectile is stepped and swept in a single pass per frame.
+ * Projectiles are authoritative on the server (impacts apply damage through the owning fire mode) and cosmetic on clients, where they drive pooled visual actors.
+ */
+UCLASS()
+class NAUSEA_API UProjectileManagerSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+//~ Begin USubsystem Interface
+public:
+	virtual void Deinitialize() override;
+//~ End USubsystem Interface
+
+//~ Begin FTickableGameObject Interface
+protected:
+	virtual void Tick(float DeltaTime) override { StepProjectiles(DeltaTime); }
+public:
+	virtual ETickableTickType GetTickableTickType() const { return ETickableTickType::Conditional; }
+	virtual bool IsTickable() const { return ProjectileIDList.Num() > 0; }
+	virtual TStatId GetStatId() const { return TStatId(); }
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+//~ End FTickableGameObject Interface
+
+public:
+	static UProjectileManagerSubsystem* Get(const UObject* WorldContextObject);
+
+	//Authoritative projectiles report their impacts to FireMode. Cosmetic projectiles only drive their visual actor.
+	FProjectileHandle SpawnProjectile(UWeaponFireMode* FireMode, const FProjectileDescription& Description, const FVector& Location, const FVector& Direction, bool bAuthoritative);
+	void DestroyProjectile(const FProjectileHandle& Handle);
+
+	int32 GetNumProjectiles() const { return ProjectileIDList.Num(); }
+
+protected:
+	void StepProjectiles(float DeltaTime);
+
+	//Returns true if the projectile should be removed.
+	bool HandleProjectileImpact(int32 ProjectileIndex, const FHitResult& Hit);
+	void HandleProjectileExpired(int32 ProjectileIndex);
+
+	//Swap removes the projectile from every state array and returns its visual actor to the pool.
+	void RemoveProjectileAt(int32 ProjectileIndex);
+
+	AActor* AcquireVisualActor(TSubclassOf<AActor> VisualActorClass);
+	void ReleaseVisualActor(AActor* VisualActor);
+
+protected:
+	//Parallel projectile state arrays. Every array always has the same number of elements.
+	UPROPERTY(Transient)
+	TArray<int32> ProjectileIDList;
+	UPROPERTY(Transient)
+	TArray<FVector> LocationList;
+	UPROPERTY(Transient)
+	TArray<FVector> VelocityList;
+	UPROPERTY(Transient)
+	TArray<float> GravityZList;
+	UPROPERTY(Transient)
+	TArray<float> ExpiryTimeList;
+	UPROPERTY(Transient)
+	TArray<int32> BouncesRemainingList;
+	UPROPERTY(Transient)
+	TArray<bool> AuthoritativeList;
+	//Description of each projectile, used when handling impacts, bounces and sweeps.
+	UPROPERTY(Transient)
+	TArray<FProjectileDescription> DescriptionList;
+	UPROPERTY(Transient)
+	TArray<TWeakObjectPtr<UWeaponFireMode>> FireModeList;
+	UPROPERTY(Transient)
+	TArray<AActor*> VisualActorList;
+
+	UPROPERTY(Transient)
+	int32 NextProjectileID = 0;
+
+	UPROPERTY(Transient)
+	TMap<UClass*, FProjectileVisualActorPool> VisualActorPoolMap;
+};
@@ -14,6 +14,7 @@ class USkeletalMeshComponent;
 class UTexture;
 class UUserWidget;
 class UAnimationObject;
+class UWeaponStaticDataSubsystem;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FWeaponStateChangedSignature, UWeapon*, Weapon, EWeaponState, State, EWeaponState, PreviousState);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FWeaponEquipSignature, UWeapon*, Weapon);
@@ -40,6 +41,7 @@ protected:
 	virtual void BeginPlay() override;
 public:
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 	virtual bool ReplicateSubobjects(class UActorChannel* Channel, class FOutBunch* Bunch, FReplicationFlags* RepFlags) override;
 
 //Disable all activation-related functionality.
@@ -195,6 +197,9 @@ public:
 	UFUNCTION()
 	virtual void ForceEquip();
 
+	//Called by fire modes when their tick is enabled or disabled. This component only ticks while at least one of its fire modes needs to.
+	void SetFireModeTickEnabled(UFireMode* FireMode, bool bTickEnabled);
+
 	//Callbacks used to start pending put downs.
 	UFUNCTION()
 	void FireCompleted(UFireMode* FireMode);
@@ -308,6 +313,10 @@ private:
 	UPROPERTY(Transient, ReplicatedUsing = OnRep_FireModeList)
 	TArray<UFireMode*> FireModeList;
 
+	//Fire modes that currently have their tick enabled.
+	UPROPERTY(Transient)
+	TArray<UFireMode*> TickingFireModeList;
+
 	UPROPERTY(Transient)
 	bool bPendingPutDown = false;
 
@@ -329,7 +338,7 @@ public:
 
 		bool operator()(const TSubclassOf<UWeapon> A, const TSubclassOf<UWeapon> B) const
 		{
-			return IsHigherPriority(A.GetDefaultObject(), B.GetDefaultObject());
+			return IsHigherPriorityClass(A, B);
 		}
 
 		bool operator()(const UWeapon& A, const UWeapon& B) const
@@ -362,6 +371,9 @@ public:
 
 			return A->GetUniqueID() < B->GetUniqueID();
 		}
+
+		//Same ordering as for instances, read from the UWeaponStaticDataSubsystem table instead of the class default objects. Both indices are resolved before either entry is read. Ties are still broken by the class default objects' UniqueID.
+		static bool IsHigherPriorityClass(TSubclassOf<UWeapon> A, TSubclassOf<UWeapon> B);
 	};
 
 	UFUNCTION(BlueprintCallable, Category = Weapon)
@@ -377,6 +389,8 @@ public:
 	static TSoftObjectPtr<UTexture> GetInventoryItemImageFromClass(TSubclassOf<UWeapon> WeaponClass);
 	UFUNCTION(BlueprintCallable, Category = Weapon)
 	static EWeaponGroup GetWeaponGroupFromClass(TSubclassOf<UWeapon> WeaponClass);
+	UFUNCTION(BlueprintCallable, Category = Weapon)
+	static uint8 GetWeaponPriorityFromClass(TSubclassOf<UWeapon> WeaponClass);
 
 	UFUNCTION(BlueprintCallable, Category = Weapon)
 	static FText GetWeaponStateName(EWeaponState State);
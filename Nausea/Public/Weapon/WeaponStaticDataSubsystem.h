@@ -0,0 +1,148 @@
+// Copyright 2020-2021 Jean-David Veilleux-Foppiano. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/EngineSubsystem.h"
+#include "Engine/World.h"
+#include "WeaponTypes.h"
+#include "WeaponStaticDataSubsystem.generated.h"
+
+class UWeapon;
+class UTexture;
+class UWeaponUserWidget;
+class UWeaponDamageType;
+class UUserWidget;
+class UAmmoUserWidget;
+
+USTRUCT(BlueprintType)
+struct FWeaponFireModeStaticData
+{
+	GENERATED_USTRUCT_BODY()
+
+	FWeaponFireModeStaticData() {}
+
+public:
+	//False if the weapon has no fire mode in this slot.
+	UPROPERTY(BlueprintReadOnly)
+	bool bValid = false;
+	UPROPERTY(BlueprintReadOnly)
+	float FireRate = 0.f;
+	UPROPERTY(BlueprintReadOnly)
+	float Damage = 0.f;
+	UPROPERTY(BlueprintReadOnly)
+	TSubclassOf<UWeaponDamageType> DamageType = nullptr;
+	UPROPERTY(BlueprintReadOnly)
+	float MaxAmmo = 0.f;
+	//Zero if the fire mode's ammo is not a ULoadedAmmo.
+	UPROPERTY(BlueprintReadOnly)
+	float MaxLoadedAmmo = 0.f;
+	UPROPERTY(BlueprintReadOnly)
+	TSoftClassPtr<UUserWidget> CrosshairWidget;
+	UPROPERTY(BlueprintReadOnly)
+	TSoftClassPtr<UAmmoUserWidget> AmmoWidget;
+};
+
+//Static data of a weapon class, copied out of its class default object (and the defaults of its fire modes and ammo) when it is added to the table. Never modified afterward.
+USTRUCT(BlueprintType)
+struct FWeaponStaticData
+{
+	GENERATED_USTRUCT_BODY()
+
+	FWeaponStaticData() {}
+
+public:
+	UPROPERTY(BlueprintReadOnly)
+	TSubclassOf<UWeapon> WeaponClass = nullptr;
+	//Index of this entry in the table.
+	UPROPERTY(BlueprintReadOnly)
+	int32 WeaponClassIndex = INDEX_NONE;
+
+	UPROPERTY(BlueprintReadOnly)
+	uint8 WeaponPriority = 0;
+	UPROPERTY(BlueprintReadOnly)
+	EWeaponGroup WeaponGroup = EWeaponGroup::None;
+
+	UPROPERTY(BlueprintReadOnly)
+	float EquipTime = 1.f;
+	UPROPERTY(BlueprintReadOnly)
+	float PutDownTime = 1.f;
+	UPROPERTY(BlueprintReadOnly)
+	float MovementSpeedModifier = 1.f;
+	UPROPERTY(BlueprintReadOnly)
+	float EquippedMovementSpeedModifier = 1.f;
+
+	UPROPERTY(BlueprintReadOnly)
+	FText WeaponName;
+	UPROPERTY(BlueprintReadOnly)
+	FText WeaponDescription;
+	UPROPERTY(BlueprintReadOnly)
+	TSoftObjectPtr<UTexture> InventoryItemImage;
+	UPROPERTY(BlueprintReadOnly)
+	TSoftClassPtr<UWeaponUserWidget> InventoryItemWidget;
+
+	//Indexed by EFireMode. Always MAXFIREMODES long.
+	UPROPERTY(BlueprintReadOnly)
+	TArray<FWeaponFireModeStaticData> FireModeData;
+};
+
+/**
+ * Flat read-only table of FWeaponStaticData. Every weapon class loaded at startup is compiled into it on initialization and classes loaded later are appended the first time they are looked up.
+ * Hot paths (weapon sorting, inventory UI, AI weapon selection, player class queries) should read from here instead of the class default object.
+ * Appending can reallocate the table, so entries are looked up by index and references to them must not be held across a lookup.
+ * The table is cleared when classes are reinstanced (Blueprint recompiles, hot reload) and when a play in editor world starts so that edited defaults are picked up.
+ */
+UCLASS()
+class NAUSEA_API UWeaponStaticDataSubsystem : public UEngineSubsystem
+{
+	GENERATED_BODY()
+
+//~ Begin USubsystem Interface
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+//~ End USubsystem Interface
+
+public:
+	static UWeaponStaticDataSubsystem* Get();
+
+	//Convenience for callers without a subsystem pointer at hand. INDEX_NONE if the subsystem is unavailable.
+	static int32 FindWeaponClassIndex(TSubclassOf<UWeapon> WeaponClass);
+
+	//Returns the table index of the given class, compiling it if it is not in the table yet. INDEX_NONE if the class is null or abstract.
+	int32 GetWeaponClassIndex(TSubclassOf<UWeapon> WeaponClass);
+
+	const FWeaponStaticData& GetWeaponStaticData(int32 WeaponClassIndex) const { return WeaponStaticDataList[WeaponClassIndex]; }
+	bool IsValidWeaponClassIndex(int32 WeaponClassIndex) const { return WeaponStaticDataList.IsValidIndex(WeaponClassIndex); }
+
+	const TArray<FWeaponStaticData>& GetWeaponStaticDataList() const { return WeaponStaticDataList; }
+
+	//Incremented every time the table is cleared. Indices cached alongside an older generation must be resolved again.
+	uint32 GetTableGeneration() const { return TableGeneration; }
+
+	//Copy of the given class' entry. Default constructed if the class is invalid.
+	UFUNCTION(BlueprintCallable, Category = Weapon)
+	static FWeaponStaticData GetStaticDataFromClass(TSubclassOf<UWeapon> WeaponClass);
+
+protected:
+	int32 CompileWeaponStaticData(TSubclassOf<UWeapon> WeaponClass);
+
+	//Clears the table so that every class is compiled again from its current defaults on its next lookup.
+	void ClearWeaponStaticData();
+
+	void OnObjectsReplaced(const TMap<UObject*, UObject*>& ReplacementMap);
+	void OnPostWorldInitialization(UWorld* World, const UWorld::InitializationValues IVS);
+
+protected:
+	UPROPERTY(Transient)
+	TArray<FWeaponStaticData> WeaponStaticDataList;
+
+	UPROPERTY(Transient)
+	TMap<UClass*, int32> WeaponClassIndexMap;
+
+	UPROPERTY(Transient)
+	uint32 TableGeneration = 1;
+
+	FDelegateHandle ObjectsReplacedHandle;
+	FDelegateHandle PostWorldInitializationHandle;
+};